@@ -0,0 +1,116 @@
+#include "benchmarks.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "gmt/ConcurrentEvent.h"
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+// The baseline: a listener list guarded by a mutex, triggers hold the lock.
+class MutexEvent
+{
+public:
+    size_t attach(std::function<void()> f)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        callbacks_.push_back({ nextId_, std::move(f) });
+        return nextId_++;
+    }
+
+    void detach(size_t id)
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        std::erase_if(callbacks_, [id](const auto &callback) { return callback.first == id; });
+    }
+
+    void operator()()
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        for (auto &callback : callbacks_) {
+            callback.second();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::pair<size_t, std::function<void()>>> callbacks_;
+    size_t nextId_{ 0 };
+};
+
+constexpr int listenersCount = 8;
+constexpr int triggersCount = 200000;
+
+// Triggers from reader threads while one more thread attaches and detaches, returns the
+// time per trigger.
+template <typename Trigger, typename Churn>
+double contended(int readers, Trigger &&trigger, Churn &&churn)
+{
+    std::atomic<bool> stop{ false };
+    std::thread writer{ [&stop, &churn]() {
+        while (!stop.load()) {
+            churn();
+        }
+    } };
+
+    const auto time = measure([readers, &trigger]() {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < readers; i++) {
+            threads.emplace_back([&trigger]() {
+                for (int j = 0; j < triggersCount; j++) {
+                    trigger();
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    });
+
+    stop = true;
+    writer.join();
+    return time / triggersCount;
+}
+
+}
+
+void concurrentEvent()
+{
+    std::atomic<int> counter{ 0 };
+    const auto increment = [&counter]() { counter.fetch_add(1, std::memory_order_relaxed); };
+
+    for (auto readers : { 1, 2, 4, 8 }) {
+        MutexEvent mutexEvent;
+        for (int i = 0; i < listenersCount; i++) {
+            mutexEvent.attach(increment);
+        }
+        report(fmt::format("MutexEvent trigger, {} threads", readers), contended(readers,
+            [&mutexEvent]() { mutexEvent(); },
+            [&mutexEvent, &increment]() { mutexEvent.detach(mutexEvent.attach(increment)); }));
+
+        ConcurrentEvent<> concurrentEvent;
+        std::vector<ConcurrentEvent<>::ListenerPtr> listeners;
+        for (int i = 0; i < listenersCount; i++) {
+            listeners.push_back(concurrentEvent.attach(increment));
+        }
+        report(fmt::format("ConcurrentEvent trigger, {} threads", readers), contended(readers,
+            [&concurrentEvent]() { concurrentEvent(); },
+            [&concurrentEvent, &increment]() { auto listener = concurrentEvent.attach(increment); }));
+    }
+}
+
+}
+
+}
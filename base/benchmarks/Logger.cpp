@@ -0,0 +1,52 @@
+#include "benchmarks.h"
+
+#include <string>
+
+#include "gmt/Logger.h"
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr int messagesCount = 1000;
+
+}
+
+void logger()
+{
+    // Messages are formatted but not written, only the cost on the logging thread matters.
+    auto &logger = Logger::shared();
+    logger.setConsole(false);
+
+    // Creates and touches this thread's ring first, messagesCount fit in it.
+    for (int i = 0; i < messagesCount; i++) {
+        logger.log("Frame ", i, " took ", 16.6);
+    }
+    logger.flush();
+
+    const std::string name = "texture.png";
+    report("Logger log, 3 arguments", measure([&logger]() {
+        for (int i = 0; i < messagesCount; i++) {
+            logger.log("Frame ", i, " took ", 16.6);
+        }
+    }) / messagesCount);
+    logger.flush();
+
+    report("Logger logf, 2 arguments", measure([&logger, &name]() {
+        for (int i = 0; i < messagesCount; i++) {
+            logger.logf("Loaded {} in {} ms", name, i);
+        }
+    }) / messagesCount);
+    logger.flush();
+
+    logger.setConsole(true);
+}
+
+}
+
+}
@@ -0,0 +1,67 @@
+#include "benchmarks.h"
+
+#include <random>
+#include <vector>
+
+#include "gmt/Random.h"
+#include "gmt/utils.h"
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t drawsCount = 1 << 16;
+constexpr int repeatsCount = 100;
+
+// Time per value of writing values with f() repeatedly.
+template <typename F>
+double perValue(std::vector<float> &values, F &&f)
+{
+    return measure([&values, &f]() {
+        for (int i = 0; i < repeatsCount; i++) {
+            f(values);
+        }
+    }) / (repeatsCount * values.size());
+}
+
+}
+
+void random()
+{
+    std::vector<float> values(drawsCount);
+
+    // What utils::random did before, a distribution per call on a shared engine.
+    std::default_random_engine standard{ 1 };
+    report("std::default_random_engine float", perValue(values, [&standard](std::vector<float> &out) {
+        for (auto &value : out) {
+            value = std::uniform_real_distribution<float>{ 0.0f, 1.0f }(standard);
+        }
+    }));
+
+    report("utils::random float", perValue(values, [](std::vector<float> &out) {
+        for (auto &value : out) {
+            value = utils::random(0.0f, 1.0f);
+        }
+    }));
+
+    auto distribution = utils::randomDistribution(0.0f, 1.0f);
+    report("utils::randomDistribution float", perValue(values, [&distribution](std::vector<float> &out) {
+        for (auto &value : out) {
+            value = distribution();
+        }
+    }));
+
+    RandomEngine engine{ 1 };
+    report("RandomEngine::fill float", perValue(values, [&engine](std::vector<float> &out) {
+        engine.fill(out.data(), out.size(), 0.0f, 1.0f);
+    }));
+}
+
+}
+
+}
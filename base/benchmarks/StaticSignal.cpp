@@ -0,0 +1,53 @@
+#include "benchmarks.h"
+
+#include "gmt/Event.h"
+#include "gmt/StaticSignal.h"
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr int triggersCount = 10000000;
+
+// Global, so the loops aren't optimized away.
+int sum = 0;
+
+void add(int value)
+{
+    sum += value;
+}
+
+void addTwice(int value)
+{
+    sum += 2 * value;
+}
+
+}
+
+void staticSignal()
+{
+    Event<int> event;
+    auto first = event.attach(&add);
+    auto second = event.attach(&addTwice);
+    report("Event trigger, 2 listeners", measure([&event]() {
+        for (int i = 0; i < triggersCount; i++) {
+            event(i);
+        }
+    }) / triggersCount);
+
+    StaticSignal<StaticListeners<&add, &addTwice>, int> signal;
+    report("StaticSignal trigger, 2 listeners", measure([&signal]() {
+        for (int i = 0; i < triggersCount; i++) {
+            signal(i);
+        }
+    }) / triggersCount);
+}
+
+}
+
+}
@@ -0,0 +1,61 @@
+#include "benchmarks.h"
+
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "gmt/math/TransformHierarchy.h"
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr int repeatsCount = 100;
+
+}
+
+void transformHierarchy()
+{
+    // 16 roots with 3 levels of 16 children below, moving the roots updates every node.
+    TransformHierarchy hierarchy;
+    std::vector<TransformHierarchy::Node> roots;
+    std::vector<TransformHierarchy::Node> level;
+    for (int i = 0; i < 16; i++) {
+        roots.push_back(hierarchy.create());
+    }
+    level = roots;
+    for (int depth = 0; depth < 3; depth++) {
+        std::vector<TransformHierarchy::Node> next;
+        for (const auto parent : level) {
+            for (int i = 0; i < 16; i++) {
+                const auto node = hierarchy.create(parent);
+                hierarchy.setLocal(node, glm::vec3{ static_cast<float>(i), 1.0f, 0.0f },
+                    glm::angleAxis(0.1f * i, glm::vec3{ 0.0f, 0.0f, 1.0f }), glm::vec3{ 0.9f });
+                next.push_back(node);
+            }
+        }
+        level = std::move(next);
+    }
+    hierarchy.update();
+
+    size_t updated = 0;
+    const auto time = measure([&hierarchy, &roots, &updated]() {
+        for (int i = 0; i < repeatsCount; i++) {
+            for (const auto root : roots) {
+                hierarchy.setPosition(root, glm::vec3{ static_cast<float>(i), 0.0f, 0.0f });
+            }
+            updated += hierarchy.update();
+        }
+    });
+    report("TransformHierarchy::update per node", time / static_cast<double>(updated));
+}
+
+}
+
+}
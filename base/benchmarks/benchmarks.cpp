@@ -0,0 +1,28 @@
+#include "benchmarks.h"
+
+#include <fmt/format.h>
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+void report(const std::string &name, double nanosecondsPerOperation)
+{
+    fmt::print("{:<48} {:>10.1f} ns\n", name, nanosecondsPerOperation);
+}
+
+}
+
+}
+
+int main()
+{
+    gmt::benchmarks::concurrentEvent();
+    gmt::benchmarks::logger();
+    gmt::benchmarks::random();
+    gmt::benchmarks::staticSignal();
+    gmt::benchmarks::transformHierarchy();
+    return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace gmt
+{
+
+namespace benchmarks
+{
+
+// Prints a result line, name padded to a column.
+void report(const std::string &name, double nanosecondsPerOperation);
+
+// Wall time of f() in nanoseconds.
+template <typename F>
+double measure(F &&f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void concurrentEvent();
+void logger();
+void random();
+void staticSignal();
+void transformHierarchy();
+
+}
+
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gmt/Event.h"
+
+namespace gmt
+{
+
+// Event safe to trigger, attach to and detach from on any thread. Triggering is wait-free: it
+// runs the callbacks of an immutable snapshot, attach and detach publish a modified copy under
+// a mutex. Callbacks may run concurrently on several threads and must be thread safe. A callback
+// detached while another thread triggers the event may still be running on that thread, and
+// unlike Event, a callback must not destroy the event it's called from.
+template <typename... Args>
+class ConcurrentEvent
+{
+public:
+    using ListenerPtr = Listener<Args...>;
+
+    template <typename T>
+    [[nodiscard]] ListenerPtr attach(T&& f) const;
+
+    template <typename T, typename Instance>
+    [[nodiscard]] ListenerPtr attach(T&& f, Instance instance) const;
+
+    void operator()(Args... args) const;
+
+    size_t getListenersCount() const;
+
+private:
+    std::shared_ptr<ConcurrentEventImpl<Args...>> eventImpl_ = std::make_shared<ConcurrentEventImpl<Args...>>();
+};
+
+// Implementation
+
+namespace details
+{
+
+// Triggers of concurrent events running on this thread, their snapshots can't be waited for.
+inline thread_local int concurrentEventDepth = 0;
+
+}
+
+// Snapshots are reclaimed the way user space RCU does it: readers register in one of two
+// counters picked by the epoch parity, a writer that replaced a snapshot flips the epoch twice
+// and waits for each counter to drain, after that no reader can still see the old snapshot.
+// Writers running inside a trigger can't wait for themselves, their snapshots are retired and
+// freed by the next writer that can wait.
+template <typename... Args>
+class ConcurrentEventImpl : public std::enable_shared_from_this<ConcurrentEventImpl<Args...>>, public details::ListenerSource
+{
+public:
+    using ListenerPtr = Listener<Args...>;
+
+    ConcurrentEventImpl() = default;
+    ConcurrentEventImpl(const ConcurrentEventImpl &) = delete;
+    ConcurrentEventImpl &operator=(const ConcurrentEventImpl &) = delete;
+
+    ~ConcurrentEventImpl()
+    {
+        delete snapshot_.load();
+        for (auto *snapshot : retired_) {
+            delete snapshot;
+        }
+    }
+
+    template <typename T>
+    ListenerPtr attach(T&& f) const
+    {
+        auto callback = std::make_shared<Callback>(details::InlineCallable<Args...>{ std::forward<T>(f) });
+
+        const Snapshot *previous;
+        uint32_t id;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            id = nextId_++;
+            callback->id = id;
+
+            auto *snapshot = new Snapshot;
+            if (auto *current = snapshot_.load()) {
+                snapshot->callbacks.reserve(current->callbacks.size() + 1);
+                snapshot->callbacks = current->callbacks;
+            }
+            snapshot->callbacks.push_back(std::move(callback));
+            previous = snapshot_.exchange(snapshot);
+        }
+        reclaim(previous);
+
+        return ListenerPtr{ this->shared_from_this(), id, 1 };
+    }
+
+    void operator()(Args&... args) const
+    {
+        const auto epoch = epoch_.load();
+        auto &readers = readers_[epoch & 1];
+        readers.fetch_add(1);
+        details::concurrentEventDepth += 1;
+
+        struct Guard
+        {
+            std::atomic<size_t> &readers;
+            ~Guard()
+            {
+                details::concurrentEventDepth -= 1;
+                readers.fetch_sub(1);
+            }
+        } guard{ readers };
+
+        if (const auto *snapshot = snapshot_.load()) {
+            for (const auto &callback : snapshot->callbacks) {
+                if (callback->alive.load(std::memory_order_relaxed)) {
+                    callback->callable(args...);
+                }
+            }
+        }
+    }
+
+    void remove(uint32_t id, uint32_t) const override
+    {
+        const Snapshot *previous = nullptr;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            const auto *current = snapshot_.load();
+            if (!current) {
+                return;
+            }
+
+            auto *snapshot = new Snapshot;
+            snapshot->callbacks.reserve(current->callbacks.size());
+            for (const auto &callback : current->callbacks) {
+                if (callback->id == id) {
+                    // Triggers still running on the old snapshot skip it from now on.
+                    callback->alive.store(false, std::memory_order_relaxed);
+                } else {
+                    snapshot->callbacks.push_back(callback);
+                }
+            }
+
+            if (snapshot->callbacks.size() == current->callbacks.size()) {
+                delete snapshot;
+                return;
+            }
+            previous = snapshot_.exchange(snapshot);
+        }
+        reclaim(previous);
+    }
+
+    size_t getListenersCount() const
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        const auto *snapshot = snapshot_.load();
+        return snapshot ? snapshot->callbacks.size() : 0;
+    }
+
+private:
+    struct Callback
+    {
+        explicit Callback(details::InlineCallable<Args...> &&callable) : callable{ std::move(callable) } {}
+
+        details::InlineCallable<Args...> callable;
+        uint32_t id{ 0 };
+        std::atomic<bool> alive{ true };
+    };
+
+    struct Snapshot
+    {
+        std::vector<std::shared_ptr<Callback>> callbacks;
+    };
+
+    void reclaim(const Snapshot *previous) const
+    {
+        std::vector<const Snapshot*> snapshots;
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            if (details::concurrentEventDepth > 0) {
+                if (previous) {
+                    retired_.push_back(previous);
+                }
+                return;
+            }
+            snapshots.swap(retired_);
+        }
+
+        if (previous) {
+            snapshots.push_back(previous);
+        }
+        if (snapshots.empty()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{ synchronizeMutex_ };
+            for (int i = 0; i < 2; i++) {
+                const auto epoch = epoch_.fetch_add(1);
+                while (readers_[epoch & 1].load() != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        for (const auto *snapshot : snapshots) {
+            delete snapshot;
+        }
+    }
+
+    mutable std::atomic<const Snapshot*> snapshot_{ nullptr };
+    mutable std::atomic<size_t> epoch_{ 0 };
+    mutable std::atomic<size_t> readers_[2]{};
+
+    mutable std::mutex mutex_;
+    mutable std::mutex synchronizeMutex_;
+    mutable std::vector<const Snapshot*> retired_;
+    mutable uint32_t nextId_{ 1 };
+};
+
+template <typename... Args>
+template <typename T>
+typename ConcurrentEvent<Args...>::ListenerPtr ConcurrentEvent<Args...>::attach(T&& f) const
+{
+    if (!eventImpl_) {
+        return {};
+    }
+    return eventImpl_->attach(std::forward<T>(f));
+}
+
+template <typename... Args>
+template <typename T, typename Instance>
+typename ConcurrentEvent<Args...>::ListenerPtr ConcurrentEvent<Args...>::attach(T&& f, Instance instance) const
+{
+    if (!eventImpl_) {
+        return {};
+    }
+
+    return eventImpl_->attach([f, instance](Args&... args) {
+        std::invoke(f, instance, args...);
+    });
+}
+
+template <typename... Args>
+void ConcurrentEvent<Args...>::operator()(Args... args) const
+{
+    if (!eventImpl_) {
+        return;
+    }
+
+    eventImpl_->operator()(args...);
+}
+
+template <typename... Args>
+size_t ConcurrentEvent<Args...>::getListenersCount() const
+{
+    if (!eventImpl_) {
+        return 0;
+    }
+
+    return eventImpl_->getListenersCount();
+}
+
+}
@@ -6,11 +6,23 @@
 
 #pragma once
 
-#include <map>
-#include <list>
-#include <memory>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "gmt/ThreadPool.h"
 
 namespace gmt
 {
@@ -21,13 +33,81 @@ class Listener;
 template <typename... Args>
 class EventImpl;
 
+template <typename... Args>
+class ConcurrentEventImpl;
+
+namespace details
+{
+
+// What a Listener detaches from.
+class ListenerSource
+{
+public:
+    virtual ~ListenerSource() = default;
+    virtual void remove(uint32_t id, uint32_t generation) const = 0;
+};
+
+// Async callbacks of one trigger that haven't finished yet.
+struct FenceState
+{
+    std::atomic<int> pending{ 0 };
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    void complete()
+    {
+        if (pending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            condition.notify_all();
+        }
+    }
+};
+
+template <typename... Args>
+class AsyncListener;
+
+// Event whose async callback the calling pool worker is running, if any.
+inline const ListenerSource *&asyncCallbackSource()
+{
+    thread_local const ListenerSource *source = nullptr;
+    return source;
+}
+
+}
+
+// Completes when the async callbacks of one trigger have run. Triggers without async
+// callbacks return a ready fence.
+class EventFence
+{
+public:
+    EventFence() = default;
+
+    bool ready() const { return !state_ || state_->pending.load() == 0; }
+
+    void wait() const
+    {
+        if (state_) {
+            std::unique_lock<std::mutex> lock{ state_->mutex };
+            state_->condition.wait(lock, [this]() { return state_->pending.load() == 0; });
+        }
+    }
+
+private:
+    template <typename... Args>
+    friend class EventImpl;
+
+    std::shared_ptr<details::FenceState> state_;
+};
+
 template <typename... Args>
 class Event
 {
 public:
-    using ListenerPtr = std::unique_ptr<Listener<Args...>>;
+    // Move-only handle, the callback stays attached while it's alive.
+    using ListenerPtr = Listener<Args...>;
 
-    // Attach a callable.
+    // Attach a callable. Callables up to details::InlineCallable::capacity bytes are stored
+    // in place, attaching them doesn't allocate once the event's storage has grown.
     template <typename T>
     [[nodiscard]] ListenerPtr attach(T&& f) const;
 
@@ -35,8 +115,21 @@ public:
     template <typename T, typename Instance>
     [[nodiscard]] ListenerPtr attach(T&& f, Instance instance) const;
 
-    // Trigger this event.
-    void operator()(Args... args);
+    // Attach a callable that runs on the pool with copies of the arguments. Calls of one
+    // async callback run one at a time in trigger order. Detaching drops its queued calls
+    // and waits for the running one. Like triggering, detaching belongs to the thread that
+    // owns the event, async callbacks run on pool workers must not detach from it.
+    template <typename T>
+    [[nodiscard]] ListenerPtr attachAsync(ThreadPool &pool, T&& f) const;
+
+    // Trigger this event. Callbacks run in the order they were attached, the ones attached
+    // while the event is running are called from the next trigger on. Async callbacks are
+    // queued, the returned fence completes when they have run.
+    EventFence operator()(Args... args);
+
+    // Waits for the queued async calls of all triggers so far, e.g. before the frame stage
+    // that depends on them. Helps running them instead of blocking a pool worker.
+    void join() const;
 
     size_t getListenersCount() const;
 
@@ -48,79 +141,443 @@ template <typename... Args>
 class Listener
 {
 public:
-    Listener(Listener &&rhs);
-    Listener &operator=(Listener &&rhs);
+    Listener() = default;
+    Listener(Listener &&rhs) noexcept;
+    Listener &operator=(Listener &&rhs) noexcept;
     ~Listener();
     void detach();
 
+    explicit operator bool() const { return !event_.expired(); }
+
+    // Pointer-like access, handles used to be heap allocated listeners.
+    Listener *operator->() { return this; }
+
 private:
-    // EventImpl<Args...> has access to this ctor.
-    Listener(std::weak_ptr<const EventImpl<Args...>> event, int id);
+    // EventImpl<Args...> and ConcurrentEventImpl<Args...> have access to this ctor.
+    Listener(std::weak_ptr<const details::ListenerSource> event, uint32_t id, uint32_t generation);
     Listener(const Listener &) = delete;
     void operator=(const Listener &) = delete;
     friend class EventImpl<Args...>;
+    friend class ConcurrentEventImpl<Args...>;
 
-    std::weak_ptr<const EventImpl<Args...>> event_;
-    int id_;
+    std::weak_ptr<const details::ListenerSource> event_;
+    uint32_t id_{ 0 };
+    uint32_t generation_{ 0 };
 };
 
 template <typename... Args>
-using ListenerPtr = std::unique_ptr<Listener<Args...>>;
+using ListenerPtr = Listener<Args...>;
 
 // Implementation
 
+namespace details
+{
+
+// Type erased void(Args&...) callable, stored in place if it's small and nothrow movable and
+// on the heap otherwise.
 template <typename... Args>
-class EventImpl : public std::enable_shared_from_this<EventImpl<Args...>>
+class InlineCallable
 {
 public:
-    using F = std::function<void(Args...)>;
-    using ListenerPtr = std::unique_ptr<Listener<Args...>>;
+    static constexpr size_t capacity = 4 * sizeof(void*);
+
+    InlineCallable() = default;
+
+    template <typename T>
+    explicit InlineCallable(T &&f);
+
+    InlineCallable(InlineCallable &&rhs) noexcept;
+    InlineCallable &operator=(InlineCallable &&rhs) noexcept;
+    ~InlineCallable() { reset(); }
+
+    void reset();
+    explicit operator bool() const { return ops_ != nullptr; }
+
+    void operator()(Args&... args) { ops_->invoke(storage_, args...); }
+
+private:
+    struct Ops
+    {
+        void (*invoke)(void *storage, Args&... args);
+        void (*move)(void *from, void *to);
+        void (*destroy)(void *storage);
+    };
+
+    template <typename T>
+    static constexpr bool fitsInline = sizeof(T) <= capacity && alignof(T) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    static constexpr Ops inlineOps{
+        [](void *storage, Args&... args) { std::invoke(*static_cast<T*>(storage), args...); },
+        [](void *from, void *to) {
+            new (to) T{ std::move(*static_cast<T*>(from)) };
+            static_cast<T*>(from)->~T();
+        },
+        [](void *storage) { static_cast<T*>(storage)->~T(); },
+    };
+
+    template <typename T>
+    static constexpr Ops heapOps{
+        [](void *storage, Args&... args) { std::invoke(**static_cast<T**>(storage), args...); },
+        [](void *from, void *to) { *static_cast<T**>(to) = *static_cast<T**>(from); },
+        [](void *storage) { delete *static_cast<T**>(storage); },
+    };
+
+    alignas(std::max_align_t) unsigned char storage_[capacity];
+    const Ops *ops_{ nullptr };
+};
+
+template <typename... Args>
+template <typename T>
+InlineCallable<Args...>::InlineCallable(T &&f)
+{
+    using F = std::decay_t<T>;
+    if constexpr (fitsInline<F>) {
+        new (storage_) F{ std::forward<T>(f) };
+        ops_ = &inlineOps<F>;
+    } else {
+        *reinterpret_cast<F**>(storage_) = new F{ std::forward<T>(f) };
+        ops_ = &heapOps<F>;
+    }
+}
+
+template <typename... Args>
+InlineCallable<Args...>::InlineCallable(InlineCallable &&rhs) noexcept
+    : ops_{ rhs.ops_ }
+{
+    if (ops_) {
+        ops_->move(rhs.storage_, storage_);
+        rhs.ops_ = nullptr;
+    }
+}
+
+template <typename... Args>
+InlineCallable<Args...> &InlineCallable<Args...>::operator=(InlineCallable &&rhs) noexcept
+{
+    if (this != &rhs) {
+        reset();
+        ops_ = rhs.ops_;
+        if (ops_) {
+            ops_->move(rhs.storage_, storage_);
+            rhs.ops_ = nullptr;
+        }
+    }
+    return *this;
+}
+
+template <typename... Args>
+void InlineCallable<Args...>::reset()
+{
+    if (ops_) {
+        ops_->destroy(storage_);
+        ops_ = nullptr;
+    }
+}
+
+// Queue of calls of one async callback. At most one thread drains it at a time, a pool
+// worker or a joining thread, so calls run in order and never concurrently.
+template <typename... Args>
+class AsyncListener : public std::enable_shared_from_this<AsyncListener<Args...>>
+{
+public:
+    template <typename T>
+    AsyncListener(const ListenerSource *source, ThreadPool &pool, T &&f)
+        : source_{ source }
+        , pool_{ pool }
+        , callable_{ std::forward<T>(f) }
+    {
+    }
+
+    void push(const std::shared_ptr<FenceState> &fence, Args&... args)
+    {
+        fence->pending += 1;
+
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        calls_.push_back({ std::tuple<std::decay_t<Args>...>{ args... }, fence });
+        if (!draining_ && !scheduled_) {
+            scheduled_ = true;
+            (void)pool_.submit([self = this->shared_from_this()]() {
+                {
+                    std::lock_guard<std::mutex> lock{ self->mutex_ };
+                    self->scheduled_ = false;
+                }
+                asyncCallbackSource() = self->source_;
+                self->drain();
+                asyncCallbackSource() = nullptr;
+            });
+        }
+    }
+
+    // Runs the queued calls on this thread if nobody is draining, waits for them otherwise.
+    void join()
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        while (!calls_.empty() || draining_) {
+            if (drainer_ == std::this_thread::get_id()) {
+                return;
+            }
+            if (draining_) {
+                idle_.wait(lock);
+            } else {
+                lock.unlock();
+                drain();
+                lock.lock();
+            }
+        }
+    }
+
+    void cancel()
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        for (auto &call : calls_) {
+            call.fence->complete();
+        }
+        calls_.clear();
+
+        if (drainer_ != std::this_thread::get_id()) {
+            idle_.wait(lock, [this]() { return !draining_; });
+        }
+    }
+
+private:
+    struct Call
+    {
+        std::tuple<std::decay_t<Args>...> args;
+        std::shared_ptr<FenceState> fence;
+    };
+
+    void drain()
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        if (draining_) {
+            return;
+        }
+        draining_ = true;
+        drainer_ = std::this_thread::get_id();
+
+        while (!calls_.empty()) {
+            auto call = std::move(calls_.front());
+            calls_.pop_front();
+            lock.unlock();
+            std::apply([this](auto &... args) { callable_(args...); }, call.args);
+            call.fence->complete();
+            lock.lock();
+        }
+
+        draining_ = false;
+        drainer_ = {};
+        idle_.notify_all();
+    }
+
+    const ListenerSource *source_;
+    ThreadPool &pool_;
+    InlineCallable<std::decay_t<Args>...> callable_;
+    std::deque<Call> calls_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    std::thread::id drainer_;
+    bool draining_{ false };
+    bool scheduled_{ false };
+};
+
+}
+
+// Callbacks live in a contiguous array in attach order, detached ones leave tombstones which
+// are compacted away once they make up half of the array. Handles address callbacks through
+// a table of generation checked ids, so a stale handle can't detach a newer callback.
+template <typename... Args>
+class EventImpl : public std::enable_shared_from_this<EventImpl<Args...>>, public details::ListenerSource
+{
+public:
+    using ListenerPtr = Listener<Args...>;
 
     EventImpl() = default;
 
     template <typename T>
     ListenerPtr attach(T&& f) const
     {
-        removeErased();
+        return attachSlot({ details::InlineCallable<Args...>{ std::forward<T>(f) } });
+    }
 
-        nextCallbackId_ += 1;
-        callbacks_.emplace(nextCallbackId_, std::forward<T>(f));
-        return ListenerPtr{ new Listener<Args...>(this->shared_from_this(), nextCallbackId_) };
+    template <typename T>
+    ListenerPtr attachAsync(ThreadPool &pool, T&& f) const
+    {
+        return attachSlot({ {}, 0, true, std::make_shared<details::AsyncListener<Args...>>(this, pool, std::forward<T>(f)) });
     }
 
-    void operator()(Args... args)
+    EventFence operator()(Args&... args)
     {
-        removeErased();
+        running_ += 1;
+        struct Guard
+        {
+            const EventImpl *event;
+            ~Guard() { event->finishRun(); }
+        } guard{ this };
+
+        EventFence fence;
+        const auto count = slots_.size();
+        for (size_t i = 0; i < count; i++) {
+            auto &slot = slots_[i];
+            if (!slot.alive) {
+                continue;
+            }
+            if (slot.async) {
+                if (!fence.state_) {
+                    fence.state_ = std::make_shared<details::FenceState>();
+                }
+                slot.async->push(fence.state_, args...);
+            } else {
+                slot.callable(args...);
+            }
+        }
+        return fence;
+    }
 
-        for (auto &pair : callbacks_) {
-            pair.second(std::forward<Args>(args)...);
+    void join() const
+    {
+        // Copied, callbacks run by join may attach and detach.
+        std::vector<std::shared_ptr<details::AsyncListener<Args...>>> async;
+        for (const auto *slots : { &slots_, &pending_ }) {
+            for (auto &slot : *slots) {
+                if (slot.alive && slot.async) {
+                    async.push_back(slot.async);
+                }
+            }
+        }
+        for (auto &listener : async) {
+            listener->join();
         }
     }
 
-    void remove(int id) const
+    void remove(uint32_t id, uint32_t generation) const override
     {
-        erased_.push_back(id);
+        // The event isn't synchronized, a pool worker can't detach while its owner triggers.
+        assert(details::asyncCallbackSource() != this && "Async callbacks must not detach from their event");
+
+        if (id >= ids_.size() || ids_[id].generation != generation) {
+            return;
+        }
+
+        // Zero marks empty handles.
+        auto &entry = ids_[id];
+        entry.generation = entry.generation + 1 ? entry.generation + 1 : 1;
+        freeIds_.push_back(id);
+
+        auto &slot = entry.slot < slots_.size() ? slots_[entry.slot] : pending_[entry.slot - slots_.size()];
+        slot.alive = false;
+        alive_ -= 1;
+        tombstones_ += 1;
+
+        if (slot.async) {
+            slot.async->cancel();
+        }
+
+        // A running callback may be detaching itself, it's destroyed after the run.
+        if (running_) {
+            deferred_ += 1;
+        } else {
+            slot.callable.reset();
+            slot.async.reset();
+            compact();
+        }
     }
 
     size_t getListenersCount() const
     {
-        removeErased();
-
-        return static_cast<size_t>(callbacks_.size());
+        return alive_;
     }
 
 private:
-    void removeErased() const
+    struct Slot
+    {
+        details::InlineCallable<Args...> callable;
+        uint32_t id{ 0 };
+        bool alive{ true };
+        std::shared_ptr<details::AsyncListener<Args...>> async{};
+    };
+
+    struct Entry
+    {
+        uint32_t slot{ 0 };
+        uint32_t generation{ 1 };
+    };
+
+    ListenerPtr attachSlot(Slot slot) const
     {
-        for (auto i : erased_) {
-            callbacks_.erase(i);
+        uint32_t id;
+        if (freeIds_.empty()) {
+            id = static_cast<uint32_t>(ids_.size());
+            ids_.push_back({});
+        } else {
+            id = freeIds_.back();
+            freeIds_.pop_back();
         }
-        erased_.clear();
+
+        // Callbacks attached while running go after the last slot, the slots array must
+        // not move under the running callback.
+        auto &entry = ids_[id];
+        entry.slot = static_cast<uint32_t>(slots_.size() + pending_.size());
+        auto &slots = running_ ? pending_ : slots_;
+        slot.id = id;
+        slots.push_back(std::move(slot));
+        alive_ += 1;
+
+        return ListenerPtr{ this->shared_from_this(), id, entry.generation };
     }
 
-    mutable std::map<int, F> callbacks_;
-    mutable std::list<int> erased_;
-    mutable int nextCallbackId_{ 0 };
+    void finishRun() const
+    {
+        running_ -= 1;
+        if (running_) {
+            return;
+        }
+
+        for (auto &slot : pending_) {
+            slots_.push_back(std::move(slot));
+        }
+        pending_.clear();
+
+        if (deferred_) {
+            for (auto &slot : slots_) {
+                if (!slot.alive) {
+                    slot.callable.reset();
+                    slot.async.reset();
+                }
+            }
+            deferred_ = 0;
+        }
+        compact();
+    }
+
+    void compact() const
+    {
+        if (!tombstones_ || tombstones_ * 2 < slots_.size()) {
+            return;
+        }
+
+        size_t count = 0;
+        for (auto &slot : slots_) {
+            if (slot.alive) {
+                ids_[slot.id].slot = static_cast<uint32_t>(count);
+                if (&slots_[count] != &slot) {
+                    slots_[count] = std::move(slot);
+                }
+                count += 1;
+            }
+        }
+        slots_.erase(slots_.begin() + count, slots_.end());
+        tombstones_ = 0;
+    }
+
+    mutable std::vector<Slot> slots_;
+    mutable std::vector<Slot> pending_;
+    mutable std::vector<Entry> ids_;
+    mutable std::vector<uint32_t> freeIds_;
+    mutable size_t alive_{ 0 };
+    mutable size_t tombstones_{ 0 };
+    mutable size_t deferred_{ 0 };
+    mutable int running_{ 0 };
 };
 
 template <typename... Args>
@@ -128,7 +585,7 @@ template <typename T>
 typename Event<Args...>::ListenerPtr Event<Args...>::attach(T&& f) const
 {
     if (!eventImpl_) {
-        return nullptr;
+        return {};
     }
     return eventImpl_->attach(std::forward<T>(f));
 }
@@ -138,22 +595,42 @@ template <typename T, typename Instance>
 typename Event<Args...>::ListenerPtr Event<Args...>::attach(T&& f, Instance instance) const
 {
     if (!eventImpl_) {
-        return nullptr;
+        return {};
     }
 
-    return eventImpl_->attach([f, instance](Args... args) {
-        std::invoke(f, instance, std::forward<Args>(args)...);
+    return eventImpl_->attach([f, instance](Args&... args) {
+        std::invoke(f, instance, args...);
     });
 }
 
 template <typename... Args>
-void Event<Args...>::operator()(Args... args)
+template <typename T>
+typename Event<Args...>::ListenerPtr Event<Args...>::attachAsync(ThreadPool &pool, T&& f) const
 {
     if (!eventImpl_) {
-        return;
+        return {};
     }
+    return eventImpl_->attachAsync(pool, std::forward<T>(f));
+}
 
-    return eventImpl_->operator()(std::forward<Args>(args)...);
+template <typename... Args>
+EventFence Event<Args...>::operator()(Args... args)
+{
+    if (!eventImpl_) {
+        return {};
+    }
+
+    // Keeps the callbacks alive if one of them destroys the event.
+    auto eventImpl = eventImpl_;
+    return eventImpl->operator()(args...);
+}
+
+template <typename... Args>
+void Event<Args...>::join() const
+{
+    if (eventImpl_) {
+        eventImpl_->join();
+    }
 }
 
 template <typename... Args>
@@ -167,23 +644,28 @@ size_t Event<Args...>::getListenersCount() const
 }
 
 template <typename... Args>
-Listener<Args...>::Listener(Listener &&rhs) : Listener(rhs.event_, rhs.id_)
+Listener<Args...>::Listener(Listener &&rhs) noexcept
+    : event_{ std::move(rhs.event_) }
+    , id_{ rhs.id_ }
+    , generation_{ rhs.generation_ }
 {
-    rhs.id_ = 0;
     rhs.event_.reset();
+    rhs.generation_ = 0;
 }
 
 template <typename... Args>
-Listener<Args...> &Listener<Args...>::operator=(Listener &&rhs)
+Listener<Args...> &Listener<Args...>::operator=(Listener &&rhs) noexcept
 {
-    detach();
+    if (this != &rhs) {
+        detach();
 
-    this->id_ = rhs.id_;
-    this->event_ = rhs.event_;
-
-    rhs.id_ = 0;
-    rhs.event_.reset();
+        event_ = std::move(rhs.event_);
+        id_ = rhs.id_;
+        generation_ = rhs.generation_;
 
+        rhs.event_.reset();
+        rhs.generation_ = 0;
+    }
     return *this;
 }
 
@@ -196,21 +678,22 @@ Listener<Args...>::~Listener()
 template <typename... Args>
 void Listener<Args...>::detach()
 {
-    if (!id_) {
+    if (!generation_) {
         return;
     }
 
     if (auto e = event_.lock()) {
-        e->remove(id_);
+        e->remove(id_, generation_);
     }
     event_.reset();
-    id_ = 0;
+    generation_ = 0;
 }
 
 template <typename... Args>
-Listener<Args...>::Listener(std::weak_ptr<const EventImpl<Args...>> event, int id)
+Listener<Args...>::Listener(std::weak_ptr<const details::ListenerSource> event, uint32_t id, uint32_t generation)
     : event_(std::move(event))
     , id_(id)
+    , generation_(generation)
 {
 }
 
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "gmt/Event.h"
+
+namespace gmt
+{
+
+// How queued events of one dispatch are folded together.
+enum class EventCoalescing
+{
+    // Every event is dispatched, in order.
+    None,
+
+    // One event, the last one pushed.
+    KeepLast,
+
+    // One event, the pushed ones folded by the merge function.
+    Merge,
+
+    // One default constructed event, only the number of pushes is kept.
+    Count,
+};
+
+// Buffers events of type T pushed during a frame and dispatches them in one batch. Listeners
+// receive the event and the number of pushed events it stands for. Not thread safe, events
+// pushed while dispatching go to the next batch.
+template <typename T>
+class EventQueue
+{
+public:
+    using ListenerPtr = typename Event<const T&, size_t>::ListenerPtr;
+
+    // merge(accumulated, next) folds next into accumulated.
+    using Merge = std::function<void(T &accumulated, const T &next)>;
+
+    explicit EventQueue(EventCoalescing coalescing = EventCoalescing::None, size_t capacity = 16);
+    explicit EventQueue(Merge merge);
+
+    template <typename F>
+    [[nodiscard]] ListenerPtr attach(F&& f) const { return event_.attach(std::forward<F>(f)); }
+
+    template <typename F, typename Instance>
+    [[nodiscard]] ListenerPtr attach(F&& f, Instance instance) const { return event_.attach(std::forward<F>(f), instance); }
+
+    void push(T event);
+
+    // Events the next dispatch delivers.
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    // Pushes since the last dispatch.
+    size_t pushedCount() const { return pushed_; }
+
+    void clear();
+
+    // Delivers the queued events to the listeners, returns how many were delivered.
+    size_t dispatch();
+
+    // Delivers the queued events to f(const T &event, size_t count) instead of the listeners.
+    template <typename F>
+    size_t dispatch(F &&f);
+
+private:
+    EventCoalescing coalescing_;
+    Merge merge_;
+    Event<const T&, size_t> event_;
+
+    // Ring of pending events without coalescing, its size is a power of two.
+    std::vector<T> ring_;
+    size_t head_{ 0 };
+    size_t count_{ 0 };
+
+    // The folded event otherwise.
+    T coalesced_{};
+    size_t pushed_{ 0 };
+
+    bool pop(T *event);
+    void grow();
+};
+
+// Implementation
+
+template <typename T>
+EventQueue<T>::EventQueue(EventCoalescing coalescing, size_t capacity)
+    : coalescing_{ coalescing }
+{
+    assert(coalescing != EventCoalescing::Merge && "Merge coalescing needs a merge function");
+
+    if (coalescing_ == EventCoalescing::None) {
+        size_t size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        ring_.resize(size);
+    }
+}
+
+template <typename T>
+EventQueue<T>::EventQueue(Merge merge)
+    : coalescing_{ EventCoalescing::Merge }
+    , merge_{ std::move(merge) }
+{
+}
+
+template <typename T>
+void EventQueue<T>::push(T event)
+{
+    pushed_ += 1;
+
+    switch (coalescing_) {
+    case EventCoalescing::None:
+        if (count_ == ring_.size()) {
+            grow();
+        }
+        ring_[(head_ + count_) & (ring_.size() - 1)] = std::move(event);
+        count_ += 1;
+        break;
+
+    case EventCoalescing::KeepLast:
+        coalesced_ = std::move(event);
+        break;
+
+    case EventCoalescing::Merge:
+        if (pushed_ == 1) {
+            coalesced_ = std::move(event);
+        } else {
+            merge_(coalesced_, event);
+        }
+        break;
+
+    case EventCoalescing::Count:
+        break;
+    }
+}
+
+template <typename T>
+size_t EventQueue<T>::size() const
+{
+    if (coalescing_ == EventCoalescing::None) {
+        return count_;
+    }
+    return pushed_ ? 1 : 0;
+}
+
+template <typename T>
+void EventQueue<T>::clear()
+{
+    T event;
+    while (pop(&event)) {
+    }
+    pushed_ = 0;
+    coalesced_ = T{};
+}
+
+template <typename T>
+size_t EventQueue<T>::dispatch()
+{
+    return dispatch([this](const T &event, size_t count) { event_(event, count); });
+}
+
+template <typename T>
+template <typename F>
+size_t EventQueue<T>::dispatch(F &&f)
+{
+    if (coalescing_ != EventCoalescing::None) {
+        if (!pushed_) {
+            return 0;
+        }
+
+        // Reset first, f may push the next batch.
+        auto event = std::move(coalesced_);
+        const auto count = pushed_;
+        coalesced_ = T{};
+        pushed_ = 0;
+        f(static_cast<const T&>(event), count);
+        return 1;
+    }
+
+    const auto count = count_;
+    pushed_ = 0;
+
+    T event;
+    for (size_t i = 0; i < count && pop(&event); i++) {
+        f(static_cast<const T&>(event), size_t{ 1 });
+    }
+    return count;
+}
+
+template <typename T>
+bool EventQueue<T>::pop(T *event)
+{
+    if (!count_) {
+        return false;
+    }
+
+    *event = std::move(ring_[head_]);
+    head_ = (head_ + 1) & (ring_.size() - 1);
+    count_ -= 1;
+    return true;
+}
+
+template <typename T>
+void EventQueue<T>::grow()
+{
+    std::vector<T> ring(ring_.size() * 2);
+    for (size_t i = 0; i < count_; i++) {
+        ring[i] = std::move(ring_[(head_ + i) & (ring_.size() - 1)]);
+    }
+    ring_.swap(ring);
+    head_ = 0;
+}
+
+}
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+// Calls below this level are compiled out, 0 trace, 1 debug, 2 info, 3 warning, 4 error and
+// 5 none. Everything is kept in debug builds and info and above in release ones.
+#ifndef GMT_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define GMT_LOG_MIN_LEVEL 2
+#else
+#define GMT_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// Logs a fmt formatted message if the level passes both the compile time minimum and the
+// category's runtime threshold. The arguments aren't evaluated otherwise.
+#define GMT_LOG(level, category, ...) \
+    do { \
+        if constexpr ((level) >= ::gmt::compiledLogLevel) { \
+            if ((category).enabled(level)) { \
+                ::gmt::Logger::shared().logf((level), (category), __VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+#define GMT_LOG_TRACE(category, ...) GMT_LOG(::gmt::LogLevel::Trace, category, __VA_ARGS__)
+#define GMT_LOG_DEBUG(category, ...) GMT_LOG(::gmt::LogLevel::Debug, category, __VA_ARGS__)
+#define GMT_LOG_INFO(category, ...) GMT_LOG(::gmt::LogLevel::Info, category, __VA_ARGS__)
+#define GMT_LOG_WARNING(category, ...) GMT_LOG(::gmt::LogLevel::Warning, category, __VA_ARGS__)
+#define GMT_LOG_ERROR(category, ...) GMT_LOG(::gmt::LogLevel::Error, category, __VA_ARGS__)
+
+namespace gmt
+{
+
+enum class LogLevel : uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    None,
+};
+
+constexpr LogLevel compiledLogLevel = static_cast<LogLevel>(GMT_LOG_MIN_LEVEL);
+
+const char *toString(LogLevel level);
+
+// Named group of messages with its own runtime threshold, e.g. one per library.
+class LogCategory
+{
+public:
+    constexpr explicit LogCategory(const char *name, LogLevel level = LogLevel::Info)
+        : name_{ name }
+        , level_{ level }
+    {
+    }
+
+    const char *name() const { return name_; }
+
+    LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+    void setLevel(LogLevel level) { level_.store(level, std::memory_order_relaxed); }
+
+    bool enabled(LogLevel level) const { return level >= this->level() && level != LogLevel::None; }
+
+private:
+    const char *name_;
+    std::atomic<LogLevel> level_;
+};
+
+// Threshold of utils::log and utils::logf.
+inline LogCategory generalLog{ "gmt" };
+
+// Specialize as std::true_type for trivially copyable types that hold no pointers, so their
+// formatting moves to the writer thread.
+template <typename T>
+struct LogByValue : std::false_type
+{
+};
+
+namespace details
+{
+
+using LogFormat = void (*)(const std::byte *payload, fmt::memory_buffer &out);
+
+struct LogRecord
+{
+    // Appends the message to out, nullptr marks padding up to the end of the ring.
+    LogFormat format;
+    uint32_t size;
+    LogLevel level;
+    int64_t time;
+
+    // Messages without a category are written without level and category.
+    const LogCategory *category;
+};
+
+// Single producer single consumer ring of log records, the producer is the logging thread.
+// Records never wrap around, the producer pads up to the end of the ring instead.
+class LogRing
+{
+public:
+    explicit LogRing(size_t size);
+
+    // nullptr if the record doesn't fit, size is a multiple of alignof(LogRecord).
+    std::byte *reserve(size_t size);
+    void commit() { head_.store(reserved_, std::memory_order_release); }
+
+    void consume(const std::function<void(const LogRecord &record, const std::byte *payload)> &f);
+
+    // Set when the producing thread exits.
+    std::atomic<bool> closed{ false };
+
+private:
+    std::unique_ptr<std::byte[]> data_;
+    size_t size_;
+    size_t reserved_{ 0 };
+    size_t cachedTail_{ 0 };
+    alignas(64) std::atomic<size_t> head_{ 0 };
+    alignas(64) std::atomic<size_t> tail_{ 0 };
+};
+
+// Strings are copied into the record, arithmetic and enum values and the types that opt in
+// with LogByValue are copied as bytes and formatted by the writer thread. Anything else is
+// formatted by the logging thread, views and pointer holding types may dangle by the time
+// the writer runs.
+template <typename T>
+constexpr bool isLogString = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+constexpr bool isLogValue = !isLogString<T> && (std::is_arithmetic_v<T> || std::is_enum_v<T> || LogByValue<T>::value);
+
+template <typename T>
+using LogCaptured = std::conditional_t<isLogValue<T>, T, std::string_view>;
+
+template <typename T>
+decltype(auto) logPrepare(const T &t)
+{
+    static_assert(!LogByValue<T>::value || std::is_trivially_copyable_v<T>, "Values logged as bytes must be trivially copyable");
+    if constexpr (isLogValue<T>) {
+        return (t);
+    } else if constexpr (isLogString<T>) {
+        return std::string_view{ t };
+    } else {
+        // Runtime, fmt rejects views passed as lvalues, they're formatted right away here.
+        return fmt::format(fmt::runtime("{}"), t);
+    }
+}
+
+template <typename T>
+size_t logSize(const T &)
+{
+    return sizeof(T);
+}
+
+inline size_t logSize(std::string_view s)
+{
+    return sizeof(uint32_t) + s.size();
+}
+
+inline size_t logSize(const std::string &s)
+{
+    return logSize(std::string_view{ s });
+}
+
+template <typename T>
+std::byte *logWrite(std::byte *out, const T &value)
+{
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+inline std::byte *logWrite(std::byte *out, std::string_view s)
+{
+    const auto size = static_cast<uint32_t>(s.size());
+    std::memcpy(out, &size, sizeof(size));
+    std::memcpy(out + sizeof(size), s.data(), size);
+    return out + sizeof(size) + size;
+}
+
+inline std::byte *logWrite(std::byte *out, const std::string &s)
+{
+    return logWrite(out, std::string_view{ s });
+}
+
+template <typename T>
+LogCaptured<T> logRead(const std::byte *&in)
+{
+    if constexpr (isLogValue<T>) {
+        alignas(T) std::byte storage[sizeof(T)];
+        std::memcpy(storage, in, sizeof(T));
+        in += sizeof(T);
+        return *std::launder(reinterpret_cast<T*>(storage));
+    } else {
+        uint32_t size;
+        std::memcpy(&size, in, sizeof(size));
+        const std::string_view s{ reinterpret_cast<const char*>(in + sizeof(size)), size };
+        in += sizeof(size) + size;
+        return s;
+    }
+}
+
+// Arguments concatenated like utils::log.
+template <typename... T>
+void logConcat(const std::byte *payload, fmt::memory_buffer &out)
+{
+    (fmt::format_to(std::back_inserter(out), "{}", logRead<T>(payload)), ...);
+}
+
+// The format string followed by the arguments, like utils::logf.
+template <typename... T>
+void logFormat(const std::byte *payload, fmt::memory_buffer &out)
+{
+    const auto format = logRead<std::string_view>(payload);
+    // Braced initialization reads the arguments in order.
+    const std::tuple<LogCaptured<T>...> args{ logRead<T>(payload)... };
+    std::apply([&out, format](const auto &... values) {
+        fmt::format_to(std::back_inserter(out), fmt::runtime(format), values...);
+    }, args);
+}
+
+}
+
+// Asynchronous logger. Logging threads copy the arguments into a ring buffer of their own,
+// a writer thread formats and timestamps the messages and writes them in batches to the
+// console and optionally a file.
+class Logger
+{
+public:
+    static Logger &shared();
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+    ~Logger();
+
+    // Arguments concatenated, formatted with "{}" each.
+    template <typename... T>
+    void log(const T &... t);
+
+    template <typename... T>
+    void logf(std::string_view format, const T &... t);
+
+    // Doesn't check the level, see GMT_LOG.
+    template <typename... T>
+    void logf(LogLevel level, const LogCategory &category, std::string_view format, const T &... t);
+
+    // Blocks until the messages logged so far by all threads are written.
+    void flush();
+
+    // Messages are appended to the file too, an empty path closes it.
+    bool setFile(const std::string &path);
+    void setConsole(bool enabled);
+
+private:
+    // Per thread, records that don't fit are formatted by the logging thread.
+    static constexpr size_t ringSize = 64 * 1024;
+
+    struct Message
+    {
+        int64_t time;
+        size_t begin;
+        size_t end;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::vector<std::shared_ptr<details::LogRing>> rings_;
+    std::vector<std::pair<int64_t, std::string>> overflow_;
+    uint64_t flushRequested_{ 0 };
+    uint64_t flushDone_{ 0 };
+    bool stopping_{ false };
+
+    std::mutex outputMutex_;
+    std::FILE *file_{ nullptr };
+    bool console_{ true };
+
+    std::thread thread_;
+
+    Logger();
+
+    details::LogRing &threadRing();
+
+    template <typename... P>
+    void write(details::LogRecord record, const P &... prepared);
+    void writeOverflow(const details::LogRecord &record, const std::byte *payload);
+
+    void run();
+    void output(const fmt::memory_buffer &text, const std::vector<Message> &messages);
+};
+
+// Implementation
+
+template <typename... T>
+void Logger::log(const T &... t)
+{
+    write({ &details::logConcat<std::decay_t<T>...>, 0, LogLevel::Info, 0, nullptr }, details::logPrepare(t)...);
+}
+
+template <typename... T>
+void Logger::logf(std::string_view format, const T &... t)
+{
+    write({ &details::logFormat<std::decay_t<T>...>, 0, LogLevel::Info, 0, nullptr }, format, details::logPrepare(t)...);
+}
+
+template <typename... T>
+void Logger::logf(LogLevel level, const LogCategory &category, std::string_view format, const T &... t)
+{
+    write({ &details::logFormat<std::decay_t<T>...>, 0, level, 0, &category }, format, details::logPrepare(t)...);
+}
+
+template <typename... P>
+void Logger::write(details::LogRecord record, const P &... prepared)
+{
+    constexpr auto alignment = alignof(details::LogRecord);
+    const auto payloadSize = (size_t{ 0 } + ... + details::logSize(prepared));
+    const auto size = (sizeof(details::LogRecord) + payloadSize + alignment - 1) & ~(alignment - 1);
+    record.size = static_cast<uint32_t>(size);
+    record.time = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    auto &ring = threadRing();
+    if (auto *out = ring.reserve(size)) {
+        new (out) details::LogRecord{ record };
+        out += sizeof(details::LogRecord);
+        ((out = details::logWrite(out, prepared)), ...);
+        ring.commit();
+        return;
+    }
+
+    std::vector<std::byte> payload(payloadSize);
+    auto *out = payload.data();
+    ((out = details::logWrite(out, prepared)), ...);
+    writeOverflow(record, payload.data());
+}
+
+}
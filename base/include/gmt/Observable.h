@@ -6,7 +6,8 @@
 
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "gmt/Weak.h"
@@ -14,47 +15,163 @@
 namespace gmt
 {
 
+// Stable handle of an added observer, stays valid while entries move around.
+struct ObserverToken
+{
+    uint32_t slot{ 0 };
+    uint32_t generation{ 0 };
+
+    explicit operator bool() const { return generation != 0; }
+};
+
+// Observers are kept in a contiguous array and notified in no particular order. Removal
+// swaps the last observer into the hole, observers destroyed without being removed are
+// compacted away in one pass after the notification that finds them.
 template <typename T>
 class Observable
 {
 public:
-    void addObserver(EnableWeakFromThis<T> *observer) const;
+    ObserverToken addObserver(EnableWeakFromThis<T> *observer) const;
+
+    // O(1) with the token, a linear search with the observer which removes all of its entries.
+    void removeObserver(ObserverToken token) const;
     void removeObserver(EnableWeakFromThis<T> *observer) const;
 
+    // Destroyed observers count until a notification compacts them away.
+    size_t getObserversCount() const { return entries_.size() - dead_; }
+
 protected:
     template <typename F>
     void notify(const F& callback) const;
 
 private:
-    mutable std::list<Weak<T>> observers_;
+    struct Entry
+    {
+        Weak<T> observer;
+        uint32_t slot;
+    };
+
+    struct Slot
+    {
+        uint32_t entry{ 0 };
+        uint32_t generation{ 1 };
+    };
+
+    mutable std::vector<Entry> entries_;
+    mutable std::vector<Slot> slots_;
+    mutable std::vector<uint32_t> freeSlots_;
+    mutable size_t dead_{ 0 };
+    mutable int notifying_{ 0 };
+
+    void erase(size_t entry) const;
+    void kill(size_t entry) const;
+    void compact() const;
 };
 
 // Implementation
 
 template <typename T>
-void Observable<T>::addObserver(EnableWeakFromThis<T> *observer) const
+ObserverToken Observable<T>::addObserver(EnableWeakFromThis<T> *observer) const
 {
-    observers_.push_back(observer->weak());
+    uint32_t slot;
+    if (freeSlots_.empty()) {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    } else {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+
+    slots_[slot].entry = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({ observer->weak(), slot });
+    return { slot, slots_[slot].generation };
+}
+
+template <typename T>
+void Observable<T>::removeObserver(ObserverToken token) const
+{
+    if (!token || token.slot >= slots_.size() || slots_[token.slot].generation != token.generation) {
+        return;
+    }
+
+    if (notifying_) {
+        kill(slots_[token.slot].entry);
+    } else {
+        erase(slots_[token.slot].entry);
+    }
 }
 
 template <typename T>
 void Observable<T>::removeObserver(EnableWeakFromThis<T> *observer) const
 {
-    observers_.remove(observer->weak());
+    // Every entry of an observer added more than once.
+    const auto *target = observer->weakTarget();
+    for (size_t i = 0; i < entries_.size();) {
+        if (entries_[i].observer.get() != target) {
+            i++;
+        } else if (notifying_) {
+            kill(i++);
+        } else {
+            erase(i);
+        }
+    }
 }
 
 template <typename T>
 template <typename F>
 void Observable<T>::notify(const F& callback) const
 {
-    for (auto it = observers_.begin(); it != observers_.end();) {
-        if (auto target = it->get()) {
+    // Observers added by the callbacks are notified too, removed ones are only marked dead.
+    notifying_ += 1;
+    bool found = false;
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (auto target = entries_[i].observer.get()) {
             callback(target);
-            ++it;
         } else {
-            it = observers_.erase(it);
+            found = true;
+        }
+    }
+    notifying_ -= 1;
+
+    if (!notifying_ && (found || dead_)) {
+        compact();
+    }
+}
+
+template <typename T>
+void Observable<T>::erase(size_t entry) const
+{
+    auto &slot = slots_[entries_[entry].slot];
+    slot.generation = slot.generation + 1 ? slot.generation + 1 : 1;
+    freeSlots_.push_back(entries_[entry].slot);
+
+    if (entry + 1 != entries_.size()) {
+        entries_[entry] = std::move(entries_.back());
+        slots_[entries_[entry].slot].entry = static_cast<uint32_t>(entry);
+    }
+    entries_.pop_back();
+}
+
+template <typename T>
+void Observable<T>::kill(size_t entry) const
+{
+    if (entries_[entry].observer.get()) {
+        entries_[entry].observer = Weak<T>{};
+        dead_ += 1;
+    }
+}
+
+template <typename T>
+void Observable<T>::compact() const
+{
+    for (size_t i = 0; i < entries_.size();) {
+        if (entries_[i].observer.get()) {
+            i++;
+        } else {
+            erase(i);
         }
     }
+    dead_ = 0;
 }
 
 }
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <glm/vec2.hpp>
+
+namespace gmt
+{
+
+// xoshiro256** run in lanes independent streams at once, so refilling the output block and
+// the bulk fills vectorize. Lane i starts i jumps after the seeded state. A uniform random
+// bit generator, usable with the standard distributions too.
+class RandomEngine
+{
+public:
+    using result_type = uint64_t;
+
+    static constexpr size_t lanes = 16;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // The state is expanded from the seed with splitmix64, equal seeds give equal sequences.
+    explicit RandomEngine(uint64_t seed = 0);
+
+    result_type operator()()
+    {
+        if (next_ == blockSize) {
+            refill();
+        }
+        return block_[next_++];
+    }
+
+    // Advances every lane by 2^192 draws, past the 2^128 apart streams of all lanes. Copies
+    // of an engine jumped 0, 1, 2... times don't overlap, e.g. one per parallel worker.
+    void jump();
+
+    // Uniform in [min, max) up to rounding for floating point types, in [min, max] for
+    // integers. Integers take Lemire's multiply-shift without rejection, the bias is below
+    // range / 2^32.
+    template <typename T> requires std::floating_point<T>
+    T uniform(T min, T max);
+
+    template <typename T> requires std::integral<T>
+    T uniform(T min, T max);
+
+    // Bulk versions of uniform.
+    void fill(float *destination, size_t count, float min, float max);
+    void fill(int32_t *destination, size_t count, int32_t min, int32_t max);
+    void fill(glm::vec2 *destination, size_t count, const glm::vec2 &min, const glm::vec2 &max);
+
+private:
+    static constexpr size_t blockSize = 4 * lanes;
+
+    // Word w of lane i is state_[w][i].
+    alignas(64) uint64_t state_[4][lanes];
+    alignas(64) uint64_t block_[blockSize];
+    size_t next_{ blockSize };
+
+    void refill();
+    void generate(uint64_t *destination);
+};
+
+// Drop-in for the standard uniform distributions on RandomEngine.
+template <typename T>
+class UniformDistribution
+{
+public:
+    using result_type = T;
+
+    UniformDistribution(T min, T max) : min_{ min }, max_{ max } {}
+
+    T operator()(RandomEngine &engine) const { return engine.uniform(min_, max_); }
+
+    T min() const { return min_; }
+    T max() const { return max_; }
+
+private:
+    T min_;
+    T max_;
+};
+
+// Engine of the calling thread. The first thread to use one gets the seed, later threads
+// get seeds derived from it in the order they first draw.
+inline RandomEngine &threadRandomEngine();
+
+// Reseeds the calling thread's engine and the ones of threads that haven't drawn yet.
+void setRandomSeed(uint64_t seed);
+
+// Implementation
+
+namespace details
+{
+
+RandomEngine &createThreadRandomEngine();
+
+}
+
+// A constant initialized pointer needs no initialization guard on every access.
+inline RandomEngine &threadRandomEngine()
+{
+    thread_local RandomEngine *engine = nullptr;
+    if (!engine) [[unlikely]] {
+        engine = &details::createThreadRandomEngine();
+    }
+    return *engine;
+}
+
+template <typename T> requires std::floating_point<T>
+T RandomEngine::uniform(T min, T max)
+{
+    if constexpr (sizeof(T) <= sizeof(float)) {
+        return min + static_cast<T>(static_cast<float>(static_cast<int32_t>((*this)() >> 40)) * 0x1.0p-24f) * (max - min);
+    } else {
+        return min + static_cast<T>(static_cast<double>(static_cast<int64_t>((*this)() >> 11)) * 0x1.0p-53) * (max - min);
+    }
+}
+
+template <typename T> requires std::integral<T>
+T RandomEngine::uniform(T min, T max)
+{
+    if constexpr (sizeof(T) <= sizeof(uint32_t)) {
+        const auto range = static_cast<uint64_t>(static_cast<int64_t>(max) - static_cast<int64_t>(min)) + 1;
+        const auto offset = (((*this)() >> 32) * range) >> 32;
+        return static_cast<T>(static_cast<int64_t>(min) + static_cast<int64_t>(offset));
+    } else {
+        return std::uniform_int_distribution<T>{ min, max }(*this);
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace gmt
+{
+
+// Single writer, many readers value without locks. Readers never block the writer,
+// they retry if a store happened while they were copying.
+template <typename T>
+class SeqLock
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock values are copied word by word");
+
+    SeqLock() { store(T{}); }
+    explicit SeqLock(const T &value) { store(value); }
+    SeqLock(const SeqLock &other) { store(other.load()); }
+    SeqLock &operator=(const SeqLock &other);
+
+    // Only one thread may store at a time.
+    void store(const T &value);
+    T load() const;
+
+private:
+    static constexpr size_t wordsCount = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> sequence_{ 0 };
+    std::atomic<uint32_t> words_[wordsCount];
+};
+
+// Implementation
+
+template <typename T>
+SeqLock<T> &SeqLock<T>::operator=(const SeqLock &other)
+{
+    if (this != &other) {
+        store(other.load());
+    }
+    return *this;
+}
+
+template <typename T>
+void SeqLock<T>::store(const T &value)
+{
+    uint32_t words[wordsCount] = {};
+    std::memcpy(words, &value, sizeof(T));
+
+    const auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < wordsCount; i++) {
+        words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+template <typename T>
+T SeqLock<T>::load() const
+{
+    uint32_t words[wordsCount];
+    for (;;) {
+        const auto before = sequence_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < wordsCount; i++) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto after = sequence_.load(std::memory_order_relaxed);
+        if (before == after && (before & 1) == 0) {
+            break;
+        }
+    }
+
+    T result;
+    std::memcpy(&result, words, sizeof(T));
+    return result;
+}
+
+}
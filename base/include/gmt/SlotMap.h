@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gmt
+{
+
+// Index and generation packed into one integer, 24 + 8 bits for 32 bit handles and
+// 32 + 32 bits for 64 bit ones. The null handle is zero.
+template <typename Id>
+class SlotMapHandle
+{
+public:
+    static_assert(std::is_same_v<Id, uint32_t> || std::is_same_v<Id, uint64_t>, "Handles are 32 or 64 bit");
+
+    static constexpr int indexBits = sizeof(Id) == 4 ? 24 : 32;
+    static constexpr Id indexMask = (Id{ 1 } << indexBits) - 1;
+    static constexpr Id maxGeneration = std::numeric_limits<Id>::max() >> indexBits;
+
+    SlotMapHandle() = default;
+    SlotMapHandle(Id index, Id generation) : value_{ index | (generation << indexBits) } {}
+
+    Id index() const { return value_ & indexMask; }
+    Id generation() const { return value_ >> indexBits; }
+    Id value() const { return value_; }
+
+    explicit operator bool() const { return value_ != 0; }
+    bool operator==(const SlotMapHandle &other) const { return value_ == other.value_; }
+    bool operator!=(const SlotMapHandle &other) const { return value_ != other.value_; }
+
+private:
+    Id value_{ 0 };
+};
+
+// Values stored densely with O(1) insert, erase and lookup through generational handles.
+// Erasing moves the last value into the hole, so pointers and iteration order aren't stable,
+// handles are. A handle of an erased value never finds a value again, like Weak::get() it
+// gets nullptr: slots whose generation would wrap around are retired instead of reused.
+template <typename T, typename Id = uint32_t>
+class SlotMap
+{
+public:
+    using Handle = SlotMapHandle<Id>;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    template <typename... Args>
+    Handle emplace(Args&&... args);
+    Handle insert(T value) { return emplace(std::move(value)); }
+
+    // Returns false if the handle is stale.
+    bool erase(Handle handle);
+    void clear();
+
+    T *get(Handle handle);
+    const T *get(Handle handle) const;
+    bool contains(Handle handle) const { return get(handle) != nullptr; }
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    void reserve(size_t size);
+
+    // Live values, contiguous.
+    iterator begin() { return values_.begin(); }
+    iterator end() { return values_.end(); }
+    const_iterator begin() const { return values_.begin(); }
+    const_iterator end() const { return values_.end(); }
+    T *data() { return values_.data(); }
+    const T *data() const { return values_.data(); }
+
+    // Handle of the value at position i of the dense array.
+    Handle handleAt(size_t i) const;
+
+private:
+    static constexpr Id none = std::numeric_limits<Id>::max();
+
+    struct Slot
+    {
+        // Position in values_ while alive, the next free slot otherwise.
+        Id target;
+        Id generation;
+    };
+
+    std::vector<T> values_;
+    std::vector<Id> valueSlots_;
+    std::vector<Slot> slots_;
+    Id freeHead_{ none };
+    Id freeTail_{ none };
+
+    const Slot *find(Handle handle) const;
+    void release(Id slot);
+};
+
+// Implementation
+
+template <typename T, typename Id>
+template <typename... Args>
+typename SlotMap<T, Id>::Handle SlotMap<T, Id>::emplace(Args&&... args)
+{
+    Id slot;
+    if (freeHead_ != none) {
+        slot = freeHead_;
+        freeHead_ = slots_[slot].target;
+        if (freeHead_ == none) {
+            freeTail_ = none;
+        }
+    } else {
+        assert(slots_.size() <= Handle::indexMask && "Out of handle indices");
+        slot = static_cast<Id>(slots_.size());
+        slots_.push_back({ none, 1 });
+    }
+
+    values_.emplace_back(std::forward<Args>(args)...);
+    valueSlots_.push_back(slot);
+    slots_[slot].target = static_cast<Id>(values_.size() - 1);
+    return { slot, slots_[slot].generation };
+}
+
+template <typename T, typename Id>
+bool SlotMap<T, Id>::erase(Handle handle)
+{
+    const auto *found = find(handle);
+    if (!found) {
+        return false;
+    }
+
+    const auto slot = handle.index();
+    const auto position = found->target;
+    if (position + 1 != values_.size()) {
+        values_[position] = std::move(values_.back());
+        valueSlots_[position] = valueSlots_.back();
+        slots_[valueSlots_[position]].target = position;
+    }
+    values_.pop_back();
+    valueSlots_.pop_back();
+    release(slot);
+    return true;
+}
+
+template <typename T, typename Id>
+void SlotMap<T, Id>::clear()
+{
+    for (const auto slot : valueSlots_) {
+        release(slot);
+    }
+    values_.clear();
+    valueSlots_.clear();
+}
+
+template <typename T, typename Id>
+T *SlotMap<T, Id>::get(Handle handle)
+{
+    const auto *slot = find(handle);
+    return slot ? &values_[slot->target] : nullptr;
+}
+
+template <typename T, typename Id>
+const T *SlotMap<T, Id>::get(Handle handle) const
+{
+    const auto *slot = find(handle);
+    return slot ? &values_[slot->target] : nullptr;
+}
+
+template <typename T, typename Id>
+void SlotMap<T, Id>::reserve(size_t size)
+{
+    values_.reserve(size);
+    valueSlots_.reserve(size);
+    slots_.reserve(size);
+}
+
+template <typename T, typename Id>
+typename SlotMap<T, Id>::Handle SlotMap<T, Id>::handleAt(size_t i) const
+{
+    const auto slot = valueSlots_[i];
+    return { slot, slots_[slot].generation };
+}
+
+template <typename T, typename Id>
+const typename SlotMap<T, Id>::Slot *SlotMap<T, Id>::find(Handle handle) const
+{
+    const auto index = handle.index();
+    if (index >= slots_.size()) {
+        return nullptr;
+    }
+
+    const auto &slot = slots_[index];
+    return slot.generation == handle.generation() && slot.generation != 0 ? &slot : nullptr;
+}
+
+template <typename T, typename Id>
+void SlotMap<T, Id>::release(Id slot)
+{
+    // Generation 0 marks retired slots, they never match a handle.
+    auto &released = slots_[slot];
+    if (released.generation == Handle::maxGeneration) {
+        released.generation = 0;
+        return;
+    }
+    released.generation += 1;
+
+    // Freed slots are reused in FIFO order, spreading generation increments over all of them.
+    released.target = none;
+    if (freeTail_ == none) {
+        freeHead_ = slot;
+    } else {
+        slots_[freeTail_].target = slot;
+    }
+    freeTail_ = slot;
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace gmt
+{
+
+// Compile time list of listeners: function pointers, member function pointers or captureless
+// lambdas, e.g. StaticListeners<&onResize, [](int, int) {}>.
+template <auto... Listeners>
+struct StaticListeners
+{
+};
+
+template <typename List, typename... Args>
+class StaticSignal;
+
+// Event with a listener list fixed at compile time. Triggering calls the listeners directly
+// in list order, no type erasure, so the calls can be inlined. Triggers like Event, for the
+// hooks whose listeners never change.
+template <auto... Listeners, typename... Args>
+class StaticSignal<StaticListeners<Listeners...>, Args...>
+{
+public:
+    static_assert((std::is_invocable_v<decltype(Listeners), Args&...> && ...), "Listener can't take the signal arguments");
+
+    // The same signal with more listeners called after these.
+    template <auto... More>
+    using With = StaticSignal<StaticListeners<Listeners..., More...>, Args...>;
+
+    void operator()(Args... args) const
+    {
+        (std::invoke(Listeners, args...), ...);
+    }
+
+    static constexpr size_t getListenersCount() { return sizeof...(Listeners); }
+};
+
+}
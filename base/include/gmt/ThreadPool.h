@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gmt
+{
+
+class ThreadPool
+{
+public:
+    // One worker per hardware thread except the calling one, but at least one worker.
+    static unsigned defaultThreadsCount();
+
+    // Pool shared by the library's parallel algorithms, created on first use.
+    static ThreadPool &shared();
+
+    explicit ThreadPool(unsigned threadsCount = defaultThreadsCount());
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    size_t size() const { return threads_.size(); }
+
+    // Queues f on a worker.
+    template <typename F>
+    [[nodiscard]] auto submit(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+    // Calls f(i) for every i in [0, count), split into chunks of grain indices.
+    // The calling thread processes chunks too, so parallelFor can be nested inside tasks.
+    template <typename F>
+    void parallelFor(size_t count, size_t grain, F &&f);
+
+private:
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_{ false };
+
+    void post(std::function<void()> task);
+    void run();
+};
+
+// Implementation
+
+template <typename F>
+auto ThreadPool::submit(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+{
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    auto result = task->get_future();
+    post([task]() { (*task)(); });
+    return result;
+}
+
+template <typename F>
+void ThreadPool::parallelFor(size_t count, size_t grain, F &&f)
+{
+    if (count == 0) {
+        return;
+    }
+
+    grain = std::max<size_t>(grain, 1);
+    const auto chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || threads_.empty()) {
+        for (size_t i = 0; i < count; i++) {
+            f(i);
+        }
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    // Helpers may start after every chunk is taken, they only touch the shared state then.
+    auto state = std::make_shared<State>();
+    auto *function = &f;
+    auto work = [state, function, count, grain, chunks]() {
+        for (;;) {
+            const auto chunk = state->next.fetch_add(1);
+            if (chunk >= chunks) {
+                return;
+            }
+
+            const auto end = std::min(count, (chunk + 1) * grain);
+            for (auto i = chunk * grain; i < end; i++) {
+                (*function)(i);
+            }
+
+            if (state->done.fetch_add(1) + 1 == chunks) {
+                std::lock_guard<std::mutex> lock{ state->mutex };
+                state->condition.notify_all();
+            }
+        }
+    };
+
+    const auto helpers = std::min(chunks - 1, threads_.size());
+    for (size_t i = 0; i < helpers; i++) {
+        post(work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock{ state->mutex };
+    state->condition.wait(lock, [&state, chunks]() { return state->done.load() == chunks; });
+}
+
+}
@@ -8,6 +8,9 @@
 
 #include <cstdio>
 #include <cassert>
+#include <atomic>
+#include <new>
+#include <thread>
 #include <type_traits>
 
 namespace gmt
@@ -23,6 +26,27 @@ struct WeakControlBlock
     T *target;
 };
 
+template <typename T>
+struct AtomicWeakControlBlock
+{
+    std::atomic<int> count;
+
+    // Pins in progress, the target's destruction waits for them.
+    std::atomic<int> pins;
+    std::atomic<T*> target;
+};
+
+// Fixed size blocks carved from slabs that are never released. Each thread caches freed blocks,
+// so allocation is a pointer pop on the common path. Blocks may be freed on any thread.
+class ControlBlockPool
+{
+public:
+    static constexpr size_t blockSize = 16;
+
+    static void *allocate();
+    static void deallocate(void *block);
+};
+
 } // end of details namespace
 
 template <typename T>
@@ -75,6 +99,9 @@ public:
 
     Weak<T> weak();
 
+    // What weak() refers to, without creating the control block.
+    T *weakTarget() const { return self_; }
+
 private:
     mutable details::WeakControlBlock<T> *controlBlock_{ nullptr };
 
@@ -82,6 +109,86 @@ private:
     details::WeakControlBlock<T> *controlBlock();
 };
 
+// Weak reference that may be copied, destroyed and locked on any thread. The target stays
+// alive while a Pin returned by lock() exists.
+template <typename T>
+class AtomicWeak
+{
+public:
+    class Pin
+    {
+    public:
+        Pin() = default;
+        Pin(Pin &&source) noexcept;
+        Pin &operator=(Pin &&source) noexcept;
+        ~Pin() { release(); }
+
+        T *get() const { return target_; }
+        explicit operator bool() const { return target_ != nullptr; }
+        T *operator->() const { return target_; }
+        T &operator*() const { return *target_; }
+
+    private:
+        friend class AtomicWeak<T>;
+        Pin(details::AtomicWeakControlBlock<T> *controlBlock, T *target);
+        void release();
+
+        details::AtomicWeakControlBlock<T> *controlBlock_{ nullptr };
+        T *target_{ nullptr };
+    };
+
+    AtomicWeak() = default;
+    AtomicWeak(details::AtomicWeakControlBlock<T> *controlBlock);
+
+    AtomicWeak(const AtomicWeak<T> &source);
+    AtomicWeak(AtomicWeak<T>&& source) noexcept;
+
+    AtomicWeak& operator=(const AtomicWeak<T> &source);
+    AtomicWeak& operator=(AtomicWeak<T>&& source) noexcept;
+
+    bool operator==(const AtomicWeak<T> &other) const { return controlBlock_ == other.controlBlock_; }
+
+    ~AtomicWeak() { releaseControlBlock(); }
+
+    /**
+      Returns nullptr if the target was destroyed. Without a pin the target may be destroyed
+      right after, use lock() to access it from another thread.
+    */
+    T* get() const;
+
+    Pin lock() const;
+
+private:
+    details::AtomicWeakControlBlock<T> *controlBlock_{ nullptr };
+
+    void releaseControlBlock();
+};
+
+// EnableWeakFromThis for objects referenced from other threads. The destructor waits for pins,
+// but it runs after the derived class is destroyed: owners whose workers may be pinning call
+// expireWeak() first thing in their destructor.
+template <typename T>
+class EnableAtomicWeakFromThis
+{
+public:
+    EnableAtomicWeakFromThis(T* self) : self_{ self } {}
+
+    EnableAtomicWeakFromThis(EnableAtomicWeakFromThis<T>&) = delete;
+    EnableAtomicWeakFromThis& operator=(EnableAtomicWeakFromThis<T>&) = delete;
+
+    virtual ~EnableAtomicWeakFromThis();
+
+    AtomicWeak<T> weak() const;
+
+    // Clears the target of the weak references and waits until no thread pins it.
+    void expireWeak();
+
+private:
+    mutable std::atomic<details::AtomicWeakControlBlock<T>*> controlBlock_{ nullptr };
+
+    T *self_;
+};
+
 // Templates Implementation ==================================================================================
 
 template <typename T>
@@ -172,7 +279,7 @@ void Weak<T>::releaseControlBlock()
         assert(controlBlock_->count > 0);
         controlBlock_->count -= 1;
         if (!controlBlock_->count) {
-            delete controlBlock_;
+            details::ControlBlockPool::deallocate(controlBlock_);
         }
         controlBlock_ = nullptr;
     }
@@ -181,8 +288,10 @@ void Weak<T>::releaseControlBlock()
 template <typename T>
 details::WeakControlBlock<T> *EnableWeakFromThis<T>::controlBlock()
 {
+    static_assert(sizeof(details::WeakControlBlock<T>) <= details::ControlBlockPool::blockSize);
+
     if (!controlBlock_) {
-        controlBlock_ = new details::WeakControlBlock<T>{ 1, self_ };
+        controlBlock_ = new (details::ControlBlockPool::allocate()) details::WeakControlBlock<T>{ 1, self_ };
     }
 
     return controlBlock_;
@@ -202,9 +311,167 @@ EnableWeakFromThis<T>::~EnableWeakFromThis()
         controlBlock_->count -= 1;
         controlBlock_->target = nullptr;
         if (!controlBlock_->count) {
-            delete controlBlock_;
+            details::ControlBlockPool::deallocate(controlBlock_);
+        }
+    }
+}
+
+template <typename T>
+AtomicWeak<T>::Pin::Pin(details::AtomicWeakControlBlock<T> *controlBlock, T *target)
+    : controlBlock_{ controlBlock }
+    , target_{ target }
+{
+}
+
+template <typename T>
+AtomicWeak<T>::Pin::Pin(Pin &&source) noexcept
+    : controlBlock_{ source.controlBlock_ }
+    , target_{ source.target_ }
+{
+    source.controlBlock_ = nullptr;
+    source.target_ = nullptr;
+}
+
+template <typename T>
+typename AtomicWeak<T>::Pin &AtomicWeak<T>::Pin::operator=(Pin &&source) noexcept
+{
+    if (this != &source) {
+        release();
+        controlBlock_ = source.controlBlock_;
+        target_ = source.target_;
+        source.controlBlock_ = nullptr;
+        source.target_ = nullptr;
+    }
+    return *this;
+}
+
+template <typename T>
+void AtomicWeak<T>::Pin::release()
+{
+    if (controlBlock_) {
+        controlBlock_->pins.fetch_sub(1);
+        controlBlock_ = nullptr;
+        target_ = nullptr;
+    }
+}
+
+template <typename T>
+AtomicWeak<T>::AtomicWeak(details::AtomicWeakControlBlock<T> *controlBlock)
+    : controlBlock_{ controlBlock }
+{
+    if (controlBlock_) {
+        controlBlock_->count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+AtomicWeak<T>::AtomicWeak(const AtomicWeak<T> &source)
+    : AtomicWeak{ source.controlBlock_ }
+{
+}
+
+template <typename T>
+AtomicWeak<T>::AtomicWeak(AtomicWeak<T>&& source) noexcept
+    : controlBlock_{ source.controlBlock_ }
+{
+    source.controlBlock_ = nullptr;
+}
+
+template <typename T>
+AtomicWeak<T>& AtomicWeak<T>::operator=(const AtomicWeak<T> &source)
+{
+    if (this != &source) {
+        AtomicWeak<T> copy{ source };
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+AtomicWeak<T>& AtomicWeak<T>::operator=(AtomicWeak<T>&& source) noexcept
+{
+    if (this != &source) {
+        releaseControlBlock();
+        controlBlock_ = source.controlBlock_;
+        source.controlBlock_ = nullptr;
+    }
+    return *this;
+}
+
+template <typename T>
+T* AtomicWeak<T>::get() const
+{
+    return controlBlock_ ? controlBlock_->target.load(std::memory_order_acquire) : nullptr;
+}
+
+template <typename T>
+typename AtomicWeak<T>::Pin AtomicWeak<T>::lock() const
+{
+    if (!controlBlock_) {
+        return {};
+    }
+
+    // Either the destructor sees the pin and waits, or the pin sees the cleared target.
+    controlBlock_->pins.fetch_add(1);
+    if (auto *target = controlBlock_->target.load()) {
+        return Pin{ controlBlock_, target };
+    }
+    controlBlock_->pins.fetch_sub(1);
+    return {};
+}
+
+template <typename T>
+void AtomicWeak<T>::releaseControlBlock()
+{
+    if (controlBlock_) {
+        if (controlBlock_->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            controlBlock_->~AtomicWeakControlBlock<T>();
+            details::ControlBlockPool::deallocate(controlBlock_);
+        }
+        controlBlock_ = nullptr;
+    }
+}
+
+template <typename T>
+AtomicWeak<T> EnableAtomicWeakFromThis<T>::weak() const
+{
+    static_assert(sizeof(details::AtomicWeakControlBlock<T>) <= details::ControlBlockPool::blockSize);
+
+    auto *controlBlock = controlBlock_.load(std::memory_order_acquire);
+    if (!controlBlock) {
+        // Threads racing to create the block keep the first one.
+        auto *created = new (details::ControlBlockPool::allocate()) details::AtomicWeakControlBlock<T>{ 1, 0, self_ };
+        if (controlBlock_.compare_exchange_strong(controlBlock, created, std::memory_order_acq_rel)) {
+            controlBlock = created;
+        } else {
+            created->~AtomicWeakControlBlock<T>();
+            details::ControlBlockPool::deallocate(created);
         }
     }
+
+    return AtomicWeak<T>{ controlBlock };
+}
+
+template <typename T>
+void EnableAtomicWeakFromThis<T>::expireWeak()
+{
+    if (auto *controlBlock = controlBlock_.load(std::memory_order_acquire)) {
+        controlBlock->target.store(nullptr);
+        while (controlBlock->pins.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <typename T>
+EnableAtomicWeakFromThis<T>::~EnableAtomicWeakFromThis()
+{
+    expireWeak();
+    auto *controlBlock = controlBlock_.load(std::memory_order_acquire);
+    if (controlBlock && controlBlock->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        controlBlock->~AtomicWeakControlBlock<T>();
+        details::ControlBlockPool::deallocate(controlBlock);
+    }
 }
 
 }
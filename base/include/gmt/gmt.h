@@ -7,13 +7,32 @@
 #pragma once
 
 #include "gmt/math/2d.h"
+#include "gmt/math/Bounds.h"
+#include "gmt/math/Bvh.h"
 #include "gmt/math/Plane.h"
+#include "gmt/math/Ray.h"
+#include "gmt/math/TransformHierarchy.h"
+#include "gmt/math/Trs.h"
+#include "gmt/mesh/Meshlets.h"
+#include "gmt/mesh/MeshView.h"
+#include "gmt/mesh/Optimize.h"
+#include "gmt/mesh/Quantize.h"
+#include "gmt/mesh/Simplify.h"
+#include "gmt/mesh/Skinning.h"
 
 #include "gmt/assets.h"
+#include "gmt/ConcurrentEvent.h"
 #include "gmt/debug.h"
 #include "gmt/easings.h"
 #include "gmt/Event.h"
+#include "gmt/EventQueue.h"
+#include "gmt/Logger.h"
 #include "gmt/Observable.h"
 #include "gmt/path.h"
+#include "gmt/Random.h"
+#include "gmt/SeqLock.h"
+#include "gmt/SlotMap.h"
+#include "gmt/StaticSignal.h"
+#include "gmt/ThreadPool.h"
 #include "gmt/utils.h"
 #include "gmt/Weak.h"
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "gmt/math/Plane.h"
+
+namespace gmt
+{
+
+struct Sphere;
+
+// Axis aligned box, default constructed empty so that it can be grown from nothing.
+struct Aabb
+{
+    static Aabb fromCenterExtents(const glm::vec3 &center, const glm::vec3 &extents);
+    static Aabb fromPoints(const glm::vec3 *points, size_t count);
+
+    bool empty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extents() const { return (max - min) * 0.5f; }
+    glm::vec3 size() const { return max - min; }
+    float area() const;
+
+    void grow(const glm::vec3 &p);
+    void grow(const Aabb &box);
+    Aabb merged(const Aabb &box) const;
+
+    // Bounds of the transformed box, m is expected to be affine.
+    Aabb transformed(const glm::mat4 &m) const;
+
+    bool contains(const glm::vec3 &p) const;
+    bool contains(const Aabb &box) const;
+    bool contains(const Sphere &sphere) const;
+    bool overlaps(const Aabb &box) const;
+    bool overlaps(const Sphere &sphere) const;
+
+    // Entirely on the negative side of the plane.
+    bool outside(const Plane &plane) const;
+
+    glm::vec3 min{ std::numeric_limits<float>::max() };
+    glm::vec3 max{ -std::numeric_limits<float>::max() };
+};
+
+struct Sphere
+{
+    static Sphere fromAabb(const Aabb &box);
+
+    // Ritter's bounding sphere, a few percent larger than the minimal one.
+    static Sphere fromPoints(const glm::vec3 *points, size_t count);
+
+    void grow(const glm::vec3 &p);
+    void grow(const Sphere &sphere);
+    Sphere merged(const Sphere &sphere) const;
+
+    // Non uniform scales grow the radius by the largest axis scale.
+    Sphere transformed(const glm::mat4 &m) const;
+
+    Aabb bounds() const { return Aabb{ center - radius, center + radius }; }
+
+    bool contains(const glm::vec3 &p) const;
+    bool contains(const Sphere &sphere) const;
+    bool contains(const Aabb &box) const;
+    bool overlaps(const Sphere &sphere) const;
+    bool overlaps(const Aabb &box) const { return box.overlaps(*this); }
+
+    bool outside(const Plane &plane) const;
+
+    glm::vec3 center{ 0.0f };
+    float radius{ -1.0f };
+};
+
+// Oriented box, axes are orthonormal columns.
+struct Obb
+{
+    // m may rotate, translate and scale but not shear.
+    static Obb fromAabb(const Aabb &box, const glm::mat4 &m = glm::mat4{ 1.0f });
+
+    Obb transformed(const glm::mat4 &m) const;
+    Aabb bounds() const;
+
+    bool contains(const glm::vec3 &p) const;
+    bool overlaps(const Obb &box) const;
+    bool overlaps(const Aabb &box) const { return overlaps(fromAabb(box)); }
+    bool overlaps(const Sphere &sphere) const;
+
+    bool outside(const Plane &plane) const;
+
+    glm::vec3 closestPoint(const glm::vec3 &p) const;
+
+    glm::vec3 center{ 0.0f };
+    glm::vec3 extents{ 0.0f };
+    glm::mat3 axes{ 1.0f };
+};
+
+// Structure of arrays containers for the batch functions below.
+
+struct AabbArray
+{
+    size_t size() const { return minX.size(); }
+    void resize(size_t size);
+    void clear() { resize(0); }
+
+    void push_back(const Aabb &box);
+    void set(size_t i, const Aabb &box);
+    Aabb get(size_t i) const;
+
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+};
+
+struct SphereArray
+{
+    size_t size() const { return x.size(); }
+    void resize(size_t size);
+    void clear() { resize(0); }
+
+    void push_back(const Sphere &sphere);
+    void set(size_t i, const Sphere &sphere);
+    Sphere get(size_t i) const;
+
+    std::vector<float> x, y, z;
+    std::vector<float> radius;
+};
+
+namespace bounds
+{
+
+// result is resized to match the input.
+void transform(const AabbArray &boxes, const glm::mat4 &m, AabbArray *result);
+void transform(const SphereArray &spheres, const glm::mat4 &m, SphereArray *result);
+
+// results[i] is 1 if the i-th element overlaps the query, 0 otherwise.
+void overlaps(const AabbArray &boxes, const Aabb &box, uint8_t *results);
+void overlaps(const SphereArray &spheres, const Sphere &sphere, uint8_t *results);
+
+// results[i] is 0 if the i-th element is outside of any plane, e.g. of a frustum with inward planes.
+// Invalid planes, like the far plane of an infinite projection, are skipped.
+void intersectsPlanes(const AabbArray &boxes, const Plane *planes, size_t planesCount, uint8_t *results);
+void intersectsPlanes(const SphereArray &spheres, const Plane *planes, size_t planesCount, uint8_t *results);
+
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "gmt/math/Bounds.h"
+#include "gmt/math/Ray.h"
+#include "gmt/mesh/MeshView.h"
+
+namespace gmt
+{
+
+class ThreadPool;
+
+// Nodes are stored depth first: an inner node's first child follows it, the second child is at
+// offset. Two nodes share a cache line.
+struct BvhNode
+{
+    bool leaf() const { return count != 0; }
+    Aabb bounds() const { return Aabb{ min, max }; }
+
+    glm::vec3 min;
+    uint32_t offset; // Second child of an inner node, first triangle packet of a leaf.
+    glm::vec3 max;
+    uint32_t count;  // Triangles in a leaf, 0 for inner nodes.
+};
+static_assert(sizeof(BvhNode) == 32, "");
+
+struct BvhHit
+{
+    float t;
+    float u;
+    float v;
+    uint32_t triangle; // Index of the triangle in the source mesh.
+};
+
+struct BvhBuildOptions
+{
+    int maxLeafSize{ 4 };
+    int binsCount{ 16 };
+
+    // Subtrees with fewer triangles are built on a single thread.
+    size_t parallelThreshold{ 4096 };
+
+    // nullptr builds on the calling thread only.
+    ThreadPool *pool{ nullptr };
+};
+
+// Bounding volume hierarchy over a static triangle mesh, built with binned SAH.
+// The triangles are copied, the source mesh is not referenced after construction.
+class Bvh
+{
+public:
+    Bvh() = default;
+    explicit Bvh(const MeshView &mesh, const BvhBuildOptions &options = {});
+
+    bool empty() const { return nodes_.empty(); }
+    const std::vector<BvhNode> &nodes() const { return nodes_; }
+
+    // Closest hit closer than tMax.
+    bool intersect(const Ray &ray, BvhHit *hit, float tMax = std::numeric_limits<float>::max(),
+        ray::Culling culling = ray::Culling::None) const;
+
+    // Any hit closer than tMax, for visibility queries.
+    bool occluded(const Ray &ray, float tMax = std::numeric_limits<float>::max(),
+        ray::Culling culling = ray::Culling::None) const;
+
+private:
+    std::vector<BvhNode> nodes_;
+    std::vector<TrianglePacket<4>> packets_;
+    std::vector<uint32_t> triangles_;
+};
+
+}
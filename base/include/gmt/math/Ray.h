@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "gmt/math/Bounds.h"
+
+namespace gmt
+{
+
+struct Ray
+{
+    // Ray through s and t, parametrized so that at(0) == s and at(1) == t.
+    static Ray fromPoints(const glm::vec3 &s, const glm::vec3 &t) { return Ray{ s, t - s }; }
+
+    glm::vec3 at(float t) const { return origin + direction * t; }
+
+    glm::vec3 origin;
+    glm::vec3 direction;
+};
+
+struct RayHit
+{
+    float t;
+    float u;
+    float v;
+};
+
+// Structure of arrays packets, the kernels below process every lane with the same instruction
+// stream, so the loops are vectorized by the compiler.
+
+template <int N>
+struct alignas(sizeof(float) * N) RayPacket
+{
+    static_assert(N == 4 || N == 8, "Ray packets are 4 or 8 wide");
+
+    void set(int lane, const Ray &ray);
+    Ray get(int lane) const;
+
+    float ox[N], oy[N], oz[N];
+    float dx[N], dy[N], dz[N];
+};
+
+template <int N>
+struct alignas(sizeof(float) * N) HitPacket
+{
+    static_assert(N == 4 || N == 8, "Hit packets are 4 or 8 wide");
+
+    // Sets every lane's t to tMax, hits further than t are rejected by the kernels.
+    void reset(float tMax = std::numeric_limits<float>::max());
+    RayHit get(int lane) const { return RayHit{ t[lane], u[lane], v[lane] }; }
+
+    float t[N];
+    float u[N];
+    float v[N];
+};
+
+// Triangles are stored as a vertex and two edges, the layout Moller-Trumbore consumes.
+template <int N>
+struct alignas(sizeof(float) * N) TrianglePacket
+{
+    static_assert(N == 4 || N == 8, "Triangle packets are 4 or 8 wide");
+
+    void set(int lane, const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2);
+
+    // Makes the lane unhittable, used to pad the last packet of a mesh.
+    void clear(int lane);
+
+    float p0x[N], p0y[N], p0z[N];
+    float e1x[N], e1y[N], e1z[N];
+    float e2x[N], e2y[N], e2z[N];
+};
+
+template <int N>
+struct alignas(sizeof(float) * N) BoxPacket
+{
+    static_assert(N == 4 || N == 8, "Box packets are 4 or 8 wide");
+
+    void set(int lane, const glm::vec3 &min, const glm::vec3 &max);
+    void set(int lane, const Aabb &box) { set(lane, box.min, box.max); }
+
+    // Makes the lane unhittable, used to pad the last packet.
+    void clear(int lane);
+
+    float minX[N], minY[N], minZ[N];
+    float maxX[N], maxY[N], maxZ[N];
+};
+
+namespace ray
+{
+
+// Triangle winding follows Plane: a triangle is front facing when the ray runs against
+// Plane{ p0, p1, p2 }.normal().
+enum class Culling
+{
+    None,
+    BackFaces,
+};
+
+bool intersectsTriangle(const Ray &ray, const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2,
+    RayHit *hit, float tMax = std::numeric_limits<float>::max(), Culling culling = Culling::None);
+
+// Slab test, on success tNear is the entry distance (or 0 if the origin is inside the box).
+bool intersectsBox(const Ray &ray, const glm::vec3 &min, const glm::vec3 &max,
+    float *tNear, float tMax = std::numeric_limits<float>::max());
+
+bool intersectsBox(const Ray &ray, const Aabb &box, float *tNear,
+    float tMax = std::numeric_limits<float>::max());
+
+// N rays against a single triangle. Lanes are only updated if the hit is closer than hits->t,
+// returns the bitmask of updated lanes.
+template <int N>
+int intersectsTriangle(const RayPacket<N> &rays, const glm::vec3 &p0, const glm::vec3 &p1,
+    const glm::vec3 &p2, HitPacket<N> *hits, Culling culling = Culling::None);
+
+// A single ray against N triangles. Lanes are only updated if the hit is closer than hits->t,
+// returns the bitmask of updated lanes.
+template <int N>
+int intersectsTriangle(const Ray &ray, const TrianglePacket<N> &triangles, HitPacket<N> *hits,
+    Culling culling = Culling::None);
+
+// A single ray against N boxes. tNear receives the entry distance of every lane,
+// returns the bitmask of boxes entered before tMax.
+template <int N>
+int intersectsBox(const Ray &ray, const BoxPacket<N> &boxes, float *tNear,
+    float tMax = std::numeric_limits<float>::max());
+
+// Returns the lane of the closest hit in mask, or -1 if mask is empty.
+template <int N>
+int closestLane(int mask, const HitPacket<N> &hits);
+
+}
+
+// Implementation
+
+namespace details
+{
+
+constexpr float rayEpsilon = 1.0e-8f;
+
+inline glm::vec3 safeInverse(const glm::vec3 &d)
+{
+    // Keeps the slab test free of 0 * inf NaNs for axis aligned rays.
+    constexpr auto big = std::numeric_limits<float>::max();
+    return {
+        d.x != 0.0f ? 1.0f / d.x : big,
+        d.y != 0.0f ? 1.0f / d.y : big,
+        d.z != 0.0f ? 1.0f / d.z : big
+    };
+}
+
+}
+
+template <int N>
+void RayPacket<N>::set(int lane, const Ray &ray)
+{
+    ox[lane] = ray.origin.x;
+    oy[lane] = ray.origin.y;
+    oz[lane] = ray.origin.z;
+    dx[lane] = ray.direction.x;
+    dy[lane] = ray.direction.y;
+    dz[lane] = ray.direction.z;
+}
+
+template <int N>
+Ray RayPacket<N>::get(int lane) const
+{
+    return Ray{ { ox[lane], oy[lane], oz[lane] }, { dx[lane], dy[lane], dz[lane] } };
+}
+
+template <int N>
+void HitPacket<N>::reset(float tMax)
+{
+    for (int i = 0; i < N; i++) {
+        t[i] = tMax;
+        u[i] = 0.0f;
+        v[i] = 0.0f;
+    }
+}
+
+template <int N>
+void TrianglePacket<N>::set(int lane, const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2)
+{
+    const auto e1 = p1 - p0;
+    const auto e2 = p2 - p0;
+    p0x[lane] = p0.x;
+    p0y[lane] = p0.y;
+    p0z[lane] = p0.z;
+    e1x[lane] = e1.x;
+    e1y[lane] = e1.y;
+    e1z[lane] = e1.z;
+    e2x[lane] = e2.x;
+    e2y[lane] = e2.y;
+    e2z[lane] = e2.z;
+}
+
+template <int N>
+void TrianglePacket<N>::clear(int lane)
+{
+    // A degenerate triangle never passes the determinant test.
+    set(lane, glm::vec3{}, glm::vec3{}, glm::vec3{});
+}
+
+template <int N>
+void BoxPacket<N>::set(int lane, const glm::vec3 &min, const glm::vec3 &max)
+{
+    minX[lane] = min.x;
+    minY[lane] = min.y;
+    minZ[lane] = min.z;
+    maxX[lane] = max.x;
+    maxY[lane] = max.y;
+    maxZ[lane] = max.z;
+}
+
+template <int N>
+void BoxPacket<N>::clear(int lane)
+{
+    // An inverted box never passes the slab test.
+    constexpr auto big = std::numeric_limits<float>::max();
+    set(lane, glm::vec3{ big }, glm::vec3{ -big });
+}
+
+namespace ray
+{
+
+template <int N>
+int intersectsTriangle(const RayPacket<N> &rays, const glm::vec3 &p0, const glm::vec3 &p1,
+    const glm::vec3 &p2, HitPacket<N> *hits, Culling culling)
+{
+    const auto e1 = p1 - p0;
+    const auto e2 = p2 - p0;
+    const auto cullBack = culling == Culling::BackFaces;
+
+    int mask = 0;
+    for (int i = 0; i < N; i++) {
+        // p = d x e2
+        const auto px = rays.dy[i] * e2.z - rays.dz[i] * e2.y;
+        const auto py = rays.dz[i] * e2.x - rays.dx[i] * e2.z;
+        const auto pz = rays.dx[i] * e2.y - rays.dy[i] * e2.x;
+        const auto det = e1.x * px + e1.y * py + e1.z * pz;
+        const auto invDet = 1.0f / det;
+
+        const auto sx = rays.ox[i] - p0.x;
+        const auto sy = rays.oy[i] - p0.y;
+        const auto sz = rays.oz[i] - p0.z;
+        const auto u = (sx * px + sy * py + sz * pz) * invDet;
+
+        // q = s x e1
+        const auto qx = sy * e1.z - sz * e1.y;
+        const auto qy = sz * e1.x - sx * e1.z;
+        const auto qz = sx * e1.y - sy * e1.x;
+        const auto v = (rays.dx[i] * qx + rays.dy[i] * qy + rays.dz[i] * qz) * invDet;
+        const auto t = (e2.x * qx + e2.y * qy + e2.z * qz) * invDet;
+
+        const bool validDet = cullBack ? det > details::rayEpsilon : std::abs(det) > details::rayEpsilon;
+        const bool hit = validDet & (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f)
+            & (t >= 0.0f) & (t < hits->t[i]);
+
+        hits->t[i] = hit ? t : hits->t[i];
+        hits->u[i] = hit ? u : hits->u[i];
+        hits->v[i] = hit ? v : hits->v[i];
+        mask |= static_cast<int>(hit) << i;
+    }
+    return mask;
+}
+
+template <int N>
+int intersectsTriangle(const Ray &ray, const TrianglePacket<N> &triangles, HitPacket<N> *hits,
+    Culling culling)
+{
+    const auto &o = ray.origin;
+    const auto &d = ray.direction;
+    const auto cullBack = culling == Culling::BackFaces;
+
+    int mask = 0;
+    for (int i = 0; i < N; i++) {
+        const auto px = d.y * triangles.e2z[i] - d.z * triangles.e2y[i];
+        const auto py = d.z * triangles.e2x[i] - d.x * triangles.e2z[i];
+        const auto pz = d.x * triangles.e2y[i] - d.y * triangles.e2x[i];
+        const auto det = triangles.e1x[i] * px + triangles.e1y[i] * py + triangles.e1z[i] * pz;
+        const auto invDet = 1.0f / det;
+
+        const auto sx = o.x - triangles.p0x[i];
+        const auto sy = o.y - triangles.p0y[i];
+        const auto sz = o.z - triangles.p0z[i];
+        const auto u = (sx * px + sy * py + sz * pz) * invDet;
+
+        const auto qx = sy * triangles.e1z[i] - sz * triangles.e1y[i];
+        const auto qy = sz * triangles.e1x[i] - sx * triangles.e1z[i];
+        const auto qz = sx * triangles.e1y[i] - sy * triangles.e1x[i];
+        const auto v = (d.x * qx + d.y * qy + d.z * qz) * invDet;
+        const auto t = (triangles.e2x[i] * qx + triangles.e2y[i] * qy + triangles.e2z[i] * qz) * invDet;
+
+        const bool validDet = cullBack ? det > details::rayEpsilon : std::abs(det) > details::rayEpsilon;
+        const bool hit = validDet & (u >= 0.0f) & (v >= 0.0f) & (u + v <= 1.0f)
+            & (t >= 0.0f) & (t < hits->t[i]);
+
+        hits->t[i] = hit ? t : hits->t[i];
+        hits->u[i] = hit ? u : hits->u[i];
+        hits->v[i] = hit ? v : hits->v[i];
+        mask |= static_cast<int>(hit) << i;
+    }
+    return mask;
+}
+
+template <int N>
+int intersectsBox(const Ray &ray, const BoxPacket<N> &boxes, float *tNear, float tMax)
+{
+    const auto &o = ray.origin;
+    const auto inv = details::safeInverse(ray.direction);
+
+    // Slabs are picked by the ray direction once, so the loop has no per lane selects.
+    const auto *nearX = inv.x >= 0.0f ? boxes.minX : boxes.maxX;
+    const auto *farX = inv.x >= 0.0f ? boxes.maxX : boxes.minX;
+    const auto *nearY = inv.y >= 0.0f ? boxes.minY : boxes.maxY;
+    const auto *farY = inv.y >= 0.0f ? boxes.maxY : boxes.minY;
+    const auto *nearZ = inv.z >= 0.0f ? boxes.minZ : boxes.maxZ;
+    const auto *farZ = inv.z >= 0.0f ? boxes.maxZ : boxes.minZ;
+
+    int mask = 0;
+    for (int i = 0; i < N; i++) {
+        const auto enter = std::max(std::max((nearX[i] - o.x) * inv.x, (nearY[i] - o.y) * inv.y),
+                                    std::max((nearZ[i] - o.z) * inv.z, 0.0f));
+        const auto exit = std::min(std::min((farX[i] - o.x) * inv.x, (farY[i] - o.y) * inv.y),
+                                   std::min((farZ[i] - o.z) * inv.z, tMax));
+
+        tNear[i] = enter;
+        mask |= static_cast<int>(enter <= exit) << i;
+    }
+    return mask;
+}
+
+template <int N>
+int closestLane(int mask, const HitPacket<N> &hits)
+{
+    int result = -1;
+    auto closest = std::numeric_limits<float>::max();
+    for (int i = 0; i < N; i++) {
+        if ((mask & (1 << i)) && hits.t[i] <= closest) {
+            closest = hits.t[i];
+            result = i;
+        }
+    }
+    return result;
+}
+
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace gmt
+{
+
+class ThreadPool;
+
+// Parent/child transforms stored as structure of arrays sorted by depth, so that a level only
+// depends on the previous one. Nodes are stable handles, their storage moves when the hierarchy
+// is reordered.
+class TransformHierarchy
+{
+public:
+    using Node = uint32_t;
+    static constexpr Node none = std::numeric_limits<Node>::max();
+
+    // Identity local transform.
+    Node create(Node parent = none);
+
+    // Destroys the node and its descendants, linear in the size of the hierarchy.
+    void destroy(Node node);
+
+    // Keeps the local transform, so the world transform follows the new parent.
+    void setParent(Node node, Node parent);
+    Node getParent(Node node) const;
+
+    bool valid(Node node) const { return node < slots_.size() && slots_[node] != none; }
+    size_t size() const { return nodes_.size(); }
+
+    void setPosition(Node node, const glm::vec3 &position);
+    void setRotation(Node node, const glm::quat &rotation);
+    void setScale(Node node, const glm::vec3 &scale);
+    void setLocal(Node node, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale);
+
+    glm::vec3 getPosition(Node node) const;
+    glm::quat getRotation(Node node) const;
+    glm::vec3 getScale(Node node) const;
+
+    // As of the last update.
+    const glm::mat4 &getWorld(Node node) const { return world_[slots_[node]]; }
+
+    // Recomputes the world matrices of the changed nodes and their descendants, a level at a time.
+    // Levels of at least parallelThreshold nodes are split across pool. Returns the number of
+    // recomputed nodes.
+    size_t update(ThreadPool *pool = nullptr, size_t parallelThreshold = 4096);
+
+    // Copies the world matrices of nodes to destination, e.g. an instance buffer mapping or the
+    // data handed to VertexBufferEditor::bufferSubData.
+    void gatherWorld(glm::mat4 *destination, const Node *nodes, size_t count) const;
+
+private:
+    // By slot.
+    std::vector<uint32_t> parents_;
+    std::vector<uint32_t> depths_;
+    std::vector<float> positionX_, positionY_, positionZ_;
+    std::vector<float> rotationX_, rotationY_, rotationZ_, rotationW_;
+    std::vector<float> scaleX_, scaleY_, scaleZ_;
+    std::vector<glm::mat4> world_;
+    std::vector<uint8_t> dirty_;
+    std::vector<Node> nodes_;
+
+    // By node, none for destroyed nodes.
+    std::vector<uint32_t> slots_;
+    std::vector<Node> freeNodes_;
+
+    // First slot of every depth, and the end.
+    std::vector<uint32_t> levels_;
+    bool unsorted_{ false };
+
+    void sort();
+    void permute(const std::vector<uint32_t> &order);
+    void updateRange(uint32_t begin, uint32_t end);
+};
+
+}
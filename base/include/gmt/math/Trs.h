@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace gmt
+{
+
+class ThreadPool;
+
+// Structure of arrays of translation, rotation and scale, rotations are expected to be unit quaternions.
+struct TrsArray
+{
+    size_t size() const { return positionX.size(); }
+    void resize(size_t size);
+    void clear() { resize(0); }
+
+    void push_back(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale);
+    void set(size_t i, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale);
+
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+    std::vector<float> scaleX, scaleY, scaleZ;
+};
+
+namespace trs
+{
+
+// translate(position) * mat4_cast(rotation) * scale(scale), without the matrix products.
+glm::mat4 toMatrix(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale);
+
+// Writes trs.size() matrices to destination, which may be a mapped instance buffer. Large arrays
+// are split into chunks across pool.
+void toMatrices(const TrsArray &trs, glm::mat4 *destination, ThreadPool *pool = nullptr);
+
+// Compact form without the constant last row: the rows of the matrix as the columns of a
+// mat3x4, so that a shader transforms with vec4(p, 1.0) * m.
+void toMatrices(const TrsArray &trs, glm::mat3x4 *destination, ThreadPool *pool = nullptr);
+
+// Implementation
+
+inline glm::mat4 toMatrix(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    const auto &q = rotation;
+    const auto xx = 2.0f * q.x * q.x, yy = 2.0f * q.y * q.y, zz = 2.0f * q.z * q.z;
+    const auto xy = 2.0f * q.x * q.y, xz = 2.0f * q.x * q.z, yz = 2.0f * q.y * q.z;
+    const auto wx = 2.0f * q.w * q.x, wy = 2.0f * q.w * q.y, wz = 2.0f * q.w * q.z;
+
+    return glm::mat4{
+        glm::vec4{ 1.0f - yy - zz, xy + wz, xz - wy, 0.0f } * scale.x,
+        glm::vec4{ xy - wz, 1.0f - xx - zz, yz + wx, 0.0f } * scale.y,
+        glm::vec4{ xz + wy, yz - wx, 1.0f - xx - yy, 0.0f } * scale.z,
+        glm::vec4{ position, 1.0f },
+    };
+}
+
+}
+
+}
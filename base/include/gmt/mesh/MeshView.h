@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <glm/glm.hpp>
+
+namespace gmt
+{
+
+// Non-owning view of an indexed triangle list. Positions are read straight from an interleaved
+// vertex array (the layout uploaded to GL_ARRAY_BUFFER), indices are 16 or 32 bit.
+class MeshView
+{
+public:
+    template <typename V, typename I>
+    MeshView(const V *vertices, size_t verticesCount, const I *indices, size_t indicesCount,
+        glm::vec3 V::*position);
+
+    template <typename I>
+    MeshView(const glm::vec3 *positions, size_t verticesCount, const I *indices, size_t indicesCount);
+
+    size_t verticesCount() const { return verticesCount_; }
+    size_t indicesCount() const { return indicesCount_; }
+    size_t trianglesCount() const { return indicesCount_ / 3; }
+
+    glm::vec3 position(uint32_t vertex) const;
+    uint32_t index(size_t i) const;
+
+    // Same vertices with another index buffer.
+    template <typename I>
+    MeshView withIndices(const I *indices, size_t indicesCount) const;
+
+private:
+    const std::byte *positions_;
+    size_t stride_;
+    size_t verticesCount_;
+
+    const void *indices_;
+    size_t indexSize_;
+    size_t indicesCount_;
+};
+
+// Implementation
+
+template <typename V, typename I>
+MeshView::MeshView(const V *vertices, size_t verticesCount, const I *indices, size_t indicesCount,
+    glm::vec3 V::*position)
+    : positions_{ vertices ? reinterpret_cast<const std::byte*>(&(vertices->*position)) : nullptr }
+    , stride_{ sizeof(V) }
+    , verticesCount_{ verticesCount }
+    , indices_{ indices }
+    , indexSize_{ sizeof(I) }
+    , indicesCount_{ indicesCount }
+{
+    static_assert(std::is_unsigned_v<I> && (sizeof(I) == 2 || sizeof(I) == 4),
+        "Indices must be 16 or 32 bit unsigned integers");
+}
+
+template <typename I>
+MeshView::MeshView(const glm::vec3 *positions, size_t verticesCount, const I *indices, size_t indicesCount)
+    : positions_{ reinterpret_cast<const std::byte*>(positions) }
+    , stride_{ sizeof(glm::vec3) }
+    , verticesCount_{ verticesCount }
+    , indices_{ indices }
+    , indexSize_{ sizeof(I) }
+    , indicesCount_{ indicesCount }
+{
+    static_assert(std::is_unsigned_v<I> && (sizeof(I) == 2 || sizeof(I) == 4),
+        "Indices must be 16 or 32 bit unsigned integers");
+}
+
+template <typename I>
+MeshView MeshView::withIndices(const I *indices, size_t indicesCount) const
+{
+    static_assert(std::is_unsigned_v<I> && (sizeof(I) == 2 || sizeof(I) == 4),
+        "Indices must be 16 or 32 bit unsigned integers");
+
+    auto result = *this;
+    result.indices_ = indices;
+    result.indexSize_ = sizeof(I);
+    result.indicesCount_ = indicesCount;
+    return result;
+}
+
+inline glm::vec3 MeshView::position(uint32_t vertex) const
+{
+    glm::vec3 result;
+    std::memcpy(&result, positions_ + vertex * stride_, sizeof(result));
+    return result;
+}
+
+inline uint32_t MeshView::index(size_t i) const
+{
+    return indexSize_ == 2
+        ? static_cast<const uint16_t*>(indices_)[i]
+        : static_cast<const uint32_t*>(indices_)[i];
+}
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "gmt/math/Bounds.h"
+#include "gmt/math/Plane.h"
+#include "gmt/mesh/MeshView.h"
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+// Limits that fit mesh shader outputs and keep local indices in a byte.
+constexpr size_t maxMeshletVertices = 64;
+constexpr size_t maxMeshletTriangles = 124;
+
+struct Meshlet
+{
+    // Ranges of Meshlets::vertices and Meshlets::triangles, the latter in triangles.
+    uint32_t verticesOffset;
+    uint32_t verticesCount;
+    uint32_t trianglesOffset;
+    uint32_t trianglesCount;
+};
+
+struct MeshletBounds
+{
+    Sphere sphere;
+
+    // The meshlet is back facing for all eyes in the cone of directions around axis, seen from
+    // apex. A zero axis never culls, triangles face too many directions.
+    glm::vec3 coneApex;
+    glm::vec3 coneAxis;
+    float coneCutoff;
+};
+
+struct Meshlets
+{
+    size_t size() const { return meshlets.size(); }
+
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;
+
+    // Source vertices of every meshlet.
+    std::vector<uint32_t> vertices;
+
+    // Three indices into the meshlet's vertices per triangle.
+    std::vector<uint8_t> triangles;
+};
+
+// Greedily grows meshlets over shared vertices, so they are compact and their cones narrow.
+// Front faces are counter clockwise.
+Meshlets buildMeshlets(const MeshView &mesh, size_t maxVertices = maxMeshletVertices,
+    size_t maxTriangles = maxMeshletTriangles);
+
+// Farthest depth pyramid of a depth buffer, for occlusion culling against the previous frame.
+class DepthPyramid
+{
+public:
+    DepthPyramid() = default;
+
+    // depth holds width x height window depths, 0 to 1, as read back from the depth buffer.
+    // Reversed depth buffers are 1 at the near plane.
+    DepthPyramid(const float *depth, uint32_t width, uint32_t height, bool reversed = false);
+
+    bool empty() const { return levels_.empty(); }
+    bool isReversed() const { return reversed_; }
+
+    size_t levelsCount() const { return levels_.size(); }
+    uint32_t getWidth(size_t level) const { return levels_[level].width; }
+    uint32_t getHeight(size_t level) const { return levels_[level].height; }
+    float getDepth(size_t level, uint32_t x, uint32_t y) const;
+
+    // Whether anything in the rectangle of the viewport, 0 to 1 with the origin at the bottom left,
+    // at the window depth nearest may be in front of the depth buffer.
+    bool visible(const glm::vec2 &min, const glm::vec2 &max, float nearest) const;
+
+private:
+    struct Level
+    {
+        uint32_t width;
+        uint32_t height;
+        std::vector<float> depth;
+    };
+
+    std::vector<Level> levels_;
+    bool reversed_{ false };
+};
+
+struct ClusterCullView
+{
+    // World space, normals inside, invalid planes are skipped. Frustum::getPlane gives these.
+    Plane planes[6];
+
+    // Eye position with w = 1, or the direction towards the eye with w = 0 for orthographic views.
+    glm::vec4 eye{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+    // Needed for the occlusion test only.
+    glm::mat4 viewProj{ 1.0f };
+    const DepthPyramid *depthPyramid{ nullptr };
+};
+
+// Appends the source indices of the meshlets passing the frustum, cone and occlusion tests to
+// indices, ready for VertexBufferEditor::bufferData. model places the mesh in the world. Returns the
+// number of meshlets kept.
+template <typename I>
+size_t cullMeshlets(const Meshlets &meshlets, const glm::mat4 &model, const ClusterCullView &view,
+    std::vector<I> *indices);
+
+// Implementation
+
+namespace details
+{
+
+// Appends the indices of the visible meshlets.
+void cullMeshlets(const Meshlets &meshlets, const glm::mat4 &model, const ClusterCullView &view,
+    std::vector<uint32_t> *visible);
+
+}
+
+template <typename I>
+size_t cullMeshlets(const Meshlets &meshlets, const glm::mat4 &model, const ClusterCullView &view,
+    std::vector<I> *indices)
+{
+    std::vector<uint32_t> visible;
+    details::cullMeshlets(meshlets, model, view, &visible);
+
+    for (const auto m : visible) {
+        const auto &meshlet = meshlets.meshlets[m];
+        const auto *vertices = meshlets.vertices.data() + meshlet.verticesOffset;
+        const auto *triangles = meshlets.triangles.data() + meshlet.trianglesOffset * 3;
+        for (size_t i = 0; i < meshlet.trianglesCount * 3; i++) {
+            indices->push_back(static_cast<I>(vertices[triangles[i]]));
+        }
+    }
+    return visible.size();
+}
+
+}
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+// Packing of vertex attributes into the compact formats of ScalarType, the way the GPU unpacks
+// them. The batch versions are branchless loops the compiler vectorizes.
+
+// IEEE half float, rounded to nearest, out of range values become infinities, tiny ones zero.
+uint16_t quantizeHalf(float value);
+float dequantizeHalf(uint16_t value);
+
+// Normalized integers, values are clamped to -1..1 (signed) or 0..1 (unsigned) and rounded.
+int8_t quantizeSnorm8(float value);
+uint8_t quantizeUnorm8(float value);
+int16_t quantizeSnorm16(float value);
+uint16_t quantizeUnorm16(float value);
+
+// GL_INT_2_10_10_10_REV and GL_UNSIGNED_INT_2_10_10_10_REV, normalized, x in the low bits.
+uint32_t packSnorm1010102(const glm::vec4 &value);
+uint32_t packUnorm1010102(const glm::vec4 &value);
+glm::vec4 unpackSnorm1010102(uint32_t value);
+
+// Unit vectors folded onto the octahedron and unfolded onto the square, -1..1 on both axes.
+glm::vec2 encodeOctahedral(const glm::vec3 &normal);
+glm::vec3 decodeOctahedral(const glm::vec2 &encoded);
+
+void quantizeHalf(uint16_t *destination, const float *values, size_t count);
+void quantizeSnorm8(int8_t *destination, const float *values, size_t count);
+void quantizeUnorm8(uint8_t *destination, const float *values, size_t count);
+void quantizeSnorm16(int16_t *destination, const float *values, size_t count);
+void quantizeUnorm16(uint16_t *destination, const float *values, size_t count);
+void packSnorm1010102(uint32_t *destination, const glm::vec4 *values, size_t count);
+void packUnorm1010102(uint32_t *destination, const glm::vec4 *values, size_t count);
+
+// Two normalized shorts per normal, the layout of ScalarType::OctahedralNormal.
+void encodeOctahedral(int16_t *destination, const glm::vec3 *normals, size_t count);
+
+// Implementation
+
+inline uint16_t quantizeHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto sign = (bits >> 16) & 0x8000u;
+    const auto magnitude = bits & 0x7fffffffu;
+
+    // Rebias the exponent from 127 to 15 and round the mantissa to 10 bits, carries into the exponent are fine.
+    auto half = (magnitude - (112u << 23) + (1u << 12)) >> 13;
+    half = magnitude < (113u << 23) ? 0u : half;
+    half = magnitude >= (143u << 23) ? 0x7c00u : half;
+    half = magnitude > (255u << 23) ? 0x7e00u : half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+inline float dequantizeHalf(uint16_t value)
+{
+    const auto sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const auto exponent = (value >> 10) & 0x1fu;
+    const auto mantissa = value & 0x3ffu;
+
+    if (exponent == 0) {
+        const auto result = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -result : result;
+    }
+
+    const auto bits = sign | (exponent == 0x1f ? 0x7f800000u : (exponent + 112) << 23) | (mantissa << 13);
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+inline int8_t quantizeSnorm8(float value)
+{
+    return static_cast<int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+
+inline uint8_t quantizeUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+inline int16_t quantizeSnorm16(float value)
+{
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+inline uint16_t quantizeUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+inline uint32_t packSnorm1010102(const glm::vec4 &value)
+{
+    const auto c = glm::round(glm::clamp(value, -1.0f, 1.0f) * glm::vec4{ 511.0f, 511.0f, 511.0f, 1.0f });
+    return (static_cast<uint32_t>(static_cast<int32_t>(c.x)) & 0x3ffu)
+        | (static_cast<uint32_t>(static_cast<int32_t>(c.y)) & 0x3ffu) << 10
+        | (static_cast<uint32_t>(static_cast<int32_t>(c.z)) & 0x3ffu) << 20
+        | (static_cast<uint32_t>(static_cast<int32_t>(c.w)) & 0x3u) << 30;
+}
+
+inline uint32_t packUnorm1010102(const glm::vec4 &value)
+{
+    const auto c = glm::round(glm::clamp(value, 0.0f, 1.0f) * glm::vec4{ 1023.0f, 1023.0f, 1023.0f, 3.0f });
+    return static_cast<uint32_t>(c.x)
+        | static_cast<uint32_t>(c.y) << 10
+        | static_cast<uint32_t>(c.z) << 20
+        | static_cast<uint32_t>(c.w) << 30;
+}
+
+inline glm::vec4 unpackSnorm1010102(uint32_t value)
+{
+    // Sign extend every field by shifting it to the top first.
+    const auto field = [value](int shift, int bits) {
+        return static_cast<float>(static_cast<int32_t>(value << (32 - shift - bits)) >> (32 - bits));
+    };
+    return glm::max(glm::vec4{ field(0, 10) / 511.0f, field(10, 10) / 511.0f, field(20, 10) / 511.0f, field(30, 2) },
+        glm::vec4{ -1.0f });
+}
+
+inline glm::vec2 encodeOctahedral(const glm::vec3 &normal)
+{
+    const auto n = normal * (1.0f / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z)));
+    if (n.z >= 0.0f) {
+        return glm::vec2{ n };
+    }
+    return glm::vec2{ (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+        (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f) };
+}
+
+inline glm::vec3 decodeOctahedral(const glm::vec2 &encoded)
+{
+    glm::vec3 n{ encoded, 1.0f - std::abs(encoded.x) - std::abs(encoded.y) };
+    const auto t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+}
+
+}
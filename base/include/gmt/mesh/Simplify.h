@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gmt/mesh/MeshView.h"
+
+namespace gmt
+{
+
+class ThreadPool;
+
+namespace mesh
+{
+
+struct LodLevel
+{
+    // Indexes the vertices of the source mesh.
+    std::vector<uint32_t> indices;
+
+    // Estimate of the distance to the source surface in mesh units, summed over the levels:
+    // the largest RMS quadric error of a collapse, the root of the area weighted mean squared
+    // distance to the planes of the merged triangles. Not a bound, single points may be farther.
+    float error;
+};
+
+// Level 0 is the source mesh, every next level is coarser.
+using LodChain = std::vector<LodLevel>;
+
+struct LodOptions
+{
+    // Including the source level.
+    int levelsCount{ 4 };
+
+    // Triangles kept from one level to the next.
+    float ratio{ 0.5f };
+
+    // Levels stop short of their triangle target rather than exceed it.
+    float maxError{ std::numeric_limits<float>::max() };
+};
+
+// Quadric error edge collapse simplification. Vertices are never moved, a vertex collapses onto one
+// of its neighbours, so the result indexes the source vertex buffer.
+// Vertices sharing a position but not attributes (UV seams) only collapse along the seam, together.
+// Open borders only collapse along themselves. Stops at targetIndicesCount indices or when the next
+// collapse would exceed maxError, error receives the error of the result.
+std::vector<uint32_t> simplify(const MeshView &mesh, size_t targetIndicesCount,
+    float maxError = std::numeric_limits<float>::max(), float *error = nullptr);
+
+LodChain buildLodChain(const MeshView &mesh, const LodOptions &options = {});
+
+// Chains of several meshes, built in parallel if pool isn't nullptr.
+std::vector<LodChain> buildLodChains(const std::vector<MeshView> &meshes, const LodOptions &options = {},
+    ThreadPool *pool = nullptr);
+
+// The coarsest level whose error projects to at most maxErrorPixels, pixelsPerUnit is the screen
+// scale at the object, e.g. from Frustum::getPixelsPerUnit. The errors are estimates, leave a
+// margin in maxErrorPixels where popping must stay below a pixel.
+size_t selectLod(const LodChain &chain, float pixelsPerUnit, float maxErrorPixels = 1.0f);
+
+}
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+namespace gmt
+{
+
+class ThreadPool;
+
+namespace mesh
+{
+
+// Skinning matrices as a structure of arrays, rows[r * 4 + c] holds element (r, c) of every
+// bone's affine matrix.
+struct MatrixPalette
+{
+    size_t size() const { return rows[0].size(); }
+    void resize(size_t size);
+
+    void set(size_t bone, const glm::mat4 &matrix);
+
+    std::vector<float> rows[12];
+};
+
+// Rigid skinning transforms as unit dual quaternions, real is the rotation and dual is
+// 0.5 * translation * rotation. Scale isn't representable.
+struct DualQuaternionPalette
+{
+    size_t size() const { return realX.size(); }
+    void resize(size_t size);
+
+    void set(size_t bone, const glm::quat &rotation, const glm::vec3 &translation);
+
+    std::vector<float> realX, realY, realZ, realW;
+    std::vector<float> dualX, dualY, dualZ, dualW;
+};
+
+// Bind pose vertices, four influences each, weights sum to one. normals may be nullptr.
+struct SkinInput
+{
+    const glm::vec3 *positions{ nullptr };
+    const glm::vec3 *normals{ nullptr };
+    const glm::u16vec4 *bones{ nullptr };
+    const glm::vec4 *weights{ nullptr };
+    size_t count{ 0 };
+};
+
+// Destination of skinned positions and normals, usually an interleaved streaming vertex buffer.
+// Normals are skipped if the vertex has none.
+class SkinOutput
+{
+public:
+    SkinOutput() = default;
+
+    template <typename V>
+    SkinOutput(V *vertices, glm::vec3 V::*position, glm::vec3 V::*normal = nullptr);
+
+    SkinOutput(glm::vec3 *positions, glm::vec3 *normals);
+
+    float *position(size_t vertex) const { return reinterpret_cast<float*>(positions_ + vertex * stride_); }
+    float *normal(size_t vertex) const { return reinterpret_cast<float*>(normals_ + vertex * stride_); }
+    bool hasNormals() const { return normals_ != nullptr; }
+
+private:
+    std::byte *positions_{ nullptr };
+    std::byte *normals_{ nullptr };
+    size_t stride_{ 0 };
+};
+
+// Linear blend skinning, normals are transformed by the blended matrix and renormalized,
+// which is exact for rotations and uniform scale.
+void skinLinear(const SkinInput &input, const MatrixPalette &palette, const SkinOutput &output);
+
+// Dual quaternion skinning, keeps the volume at twisting joints.
+void skinDualQuaternion(const SkinInput &input, const DualQuaternionPalette &palette, const SkinOutput &output);
+
+struct LinearSkinJob
+{
+    SkinInput input;
+    const MatrixPalette *palette;
+    SkinOutput output;
+};
+
+struct DualQuaternionSkinJob
+{
+    SkinInput input;
+    const DualQuaternionPalette *palette;
+    SkinOutput output;
+};
+
+// Skins several meshes, in parallel across meshes and chunks of large meshes if pool isn't nullptr.
+void skin(const LinearSkinJob *jobs, size_t count, ThreadPool *pool = nullptr);
+void skin(const DualQuaternionSkinJob *jobs, size_t count, ThreadPool *pool = nullptr);
+
+// Implementation
+
+template <typename V>
+SkinOutput::SkinOutput(V *vertices, glm::vec3 V::*position, glm::vec3 V::*normal)
+    : positions_{ reinterpret_cast<std::byte*>(&(vertices->*position)) }
+    , normals_{ normal ? reinterpret_cast<std::byte*>(&(vertices->*normal)) : nullptr }
+    , stride_{ sizeof(V) }
+{
+}
+
+inline SkinOutput::SkinOutput(glm::vec3 *positions, glm::vec3 *normals)
+    : positions_{ reinterpret_cast<std::byte*>(positions) }
+    , normals_{ reinterpret_cast<std::byte*>(normals) }
+    , stride_{ sizeof(glm::vec3) }
+{
+}
+
+}
+
+}
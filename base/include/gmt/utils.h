@@ -6,16 +6,9 @@
 
 #pragma once
 
-#ifdef __ANDROID__
-#include <android/log.h>
-#elif defined(_WIN32)
-#include <iostream>
-#endif
-
 #include <concepts>
 #include <cstdlib>
 #include <ctime>
-#include <iomanip>
 #include <memory>
 #include <random>
 #include <sstream>
@@ -25,13 +18,8 @@
 #include <fmt/format.h>
 #include <glm/glm.hpp>
 
-#ifdef __ANDROID__
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, "gmt", __VA_ARGS__)
-#elif defined(_WIN32) || defined(__APPLE__)
-#define LOGI(...) { printf(__VA_ARGS__); printf("\n"); }
-#else
-#define LOGI(...) CCLOG(__VA_ARGS__)
-#endif
+#include "gmt/Logger.h"
+#include "gmt/Random.h"
 
 template<typename T, size_t N>
 static T* begin(T (&arr)[N])
@@ -54,39 +42,6 @@ constexpr size_t length(T (&arr)[N])
 namespace details
 {
 
-inline void log(fmt::memory_buffer &ss)
-{
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-security"
-#endif
-
-    time_t rawtime;
-    time(&rawtime);
-#if defined(__ANDROID__) || defined(__APPLE__)
-    const struct tm* timeinfo = std::localtime(&rawtime);
-#else
-    std::tm localtime;
-    localtime_s(&localtime, &rawtime);
-    auto timeinfo = &localtime;
-#endif
-
-    std::ostringstream os;
-    os << std::put_time(timeinfo, "%H:%M:%S");
-
-    LOGI("%s: %s", os.str().c_str(), std::string{ ss.data(), ss.size() }.c_str());
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
-}
-
-template <typename H, typename... T>
-void log(fmt::memory_buffer &ss, H h, T... t)
-{
-    fmt::format_to(std::back_inserter(ss), "{}", h);
-    log(ss, t...);
-}
-
 inline std::string concat(fmt::memory_buffer &ss)
 {
     return std::string{ ss.data(), ss.size() };
@@ -98,7 +53,11 @@ std::string concat(fmt::memory_buffer &ss, const H &h, const T & ... t) {
     return concat(ss, t...);
 }
 
-std::default_random_engine &randomEngine();
+// The calling thread's engine.
+inline gmt::RandomEngine &randomEngine()
+{
+    return gmt::threadRandomEngine();
+}
 
 }
 
@@ -108,6 +67,8 @@ namespace gmt
 namespace utils
 {
 
+// Asynchronous info messages, see Logger. Nothing is captured below generalLog's threshold,
+// the GMT_LOG macros add levels, categories and compiling out.
 template <typename... T>
 void log(T... t);
 
@@ -117,9 +78,6 @@ void logf(F&& format, T... t);
 template <typename F>
 void logf(F&& format);
 
-inline void log(const std::string &str);
-inline void log(const char *str);
-
 template <typename... T>
 std::string concat(const T & ... t);
 
@@ -128,57 +86,51 @@ void split(std::string s, char delim, Out destination);
 
 long getTime(void);
 
+// Draws from the engine of the calling thread, so a distribution without state of its own
+// can be shared between threads.
 template <typename T>
 class Distribution
 {
 public:
-    Distribution(T dist, std::default_random_engine &engine)
+    explicit Distribution(T dist)
         : dist_{ std::move(dist) }
-        , engine_{ engine }
     {
     }
 
-    auto operator()() { return dist_(engine_); }
+    auto operator()() { return dist_(::details::randomEngine()); }
 
 private:
     T dist_;
-    std::default_random_engine &engine_;
 };
 
 template <typename T> requires std::floating_point<T>
 auto randomDistribution(T min, T max)
 {
-    using D = std::uniform_real_distribution<T>;
-    D actualDistribution{ min, max };
-    return Distribution<D>(actualDistribution, ::details::randomEngine());
+    return Distribution<UniformDistribution<T>>(UniformDistribution<T>{ min, max });
 }
 
 template <typename T> requires std::integral<T>
 auto randomDistribution(T min, T max)
 {
-    using D = std::uniform_int_distribution<T>;
-    D actualDistribution{ min, max };
-    return Distribution<D>(actualDistribution, ::details::randomEngine());
+    return Distribution<UniformDistribution<T>>(UniformDistribution<T>{ min, max });
 }
 
 template <typename K> requires (!std::integral<K> && !std::floating_point<K>)
 auto randomDistribution(K distribution)
 {
-    return Distribution<K>(distribution, ::details::randomEngine());
+    return Distribution<K>(distribution);
 }
 
 template <typename T, typename std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
 T random(T min, T max)
 {
-    std::uniform_real_distribution<T> dist(min, max);
-    return dist(::details::randomEngine());
+    return ::details::randomEngine().uniform(min, max);
 }
 
 template <typename T, typename std::enable_if_t<std::is_integral_v<T>, bool> = true>
 T random(T min, T max)
 {
-    std::uniform_int_distribution<T> dist(min, max);
-    return dist(::details::randomEngine());
+    return ::details::randomEngine().uniform(min, max);
 }
 
 template <typename T>
@@ -219,6 +171,7 @@ void assume(T&& condition, Args&&... args)
 {
     if (!condition) {
         utils::logf(std::forward<Args>(args)...);
+        Logger::shared().flush();
         std::abort();
     }
 }
@@ -248,44 +201,25 @@ namespace utils
 template <typename... T>
 void log(T... t)
 {
-    fmt::memory_buffer ss;
-    ::details::log(ss, t...);
+    if (generalLog.enabled(LogLevel::Info)) {
+        Logger::shared().log(t...);
+    }
 }
 
 template <typename F, typename... T>
 void logf(F&& format, T... t)
 {
-    log(fmt::format(fmt::runtime(format), std::forward<T>(t)...));
+    if (generalLog.enabled(LogLevel::Info)) {
+        Logger::shared().logf(std::forward<F>(format), t...);
+    }
 }
 
 template <typename F>
 void logf(F&& format)
 {
-    log(std::forward<F>(format));
-}
-
-void log(const std::string &str)
-{
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-security"
-#endif
-   LOGI(str.c_str());
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
-}
-
-void log(const char *str)
-{
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-security"
-#endif
-    LOGI(str);
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
+    if (generalLog.enabled(LogLevel::Info)) {
+        Logger::shared().log(std::forward<F>(format));
+    }
 }
 
 template <typename Out>
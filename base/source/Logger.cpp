@@ -0,0 +1,308 @@
+#include "gmt/Logger.h"
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+#include <algorithm>
+#include <ctime>
+#include <exception>
+
+namespace gmt
+{
+
+namespace details
+{
+
+LogRing::LogRing(size_t size)
+    : data_{ new std::byte[size] }
+    , size_{ size }
+{
+}
+
+std::byte *LogRing::reserve(size_t size)
+{
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto position = head & (size_ - 1);
+    const auto padding = position + size > size_ ? size_ - position : 0;
+    const auto needed = padding + size;
+    if (head + needed - cachedTail_ > size_) {
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        if (head + needed - cachedTail_ > size_) {
+            return nullptr;
+        }
+    }
+
+    // Shorter paddings than a record are skipped without a marker.
+    if (padding >= sizeof(LogRecord)) {
+        new (data_.get() + position) LogRecord{ nullptr, static_cast<uint32_t>(padding), LogLevel::None, 0, nullptr };
+    }
+    reserved_ = head + needed;
+    return data_.get() + ((head + padding) & (size_ - 1));
+}
+
+void LogRing::consume(const std::function<void(const LogRecord &record, const std::byte *payload)> &f)
+{
+    auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    while (tail != head) {
+        const auto position = tail & (size_ - 1);
+        if (size_ - position < sizeof(LogRecord)) {
+            tail += size_ - position;
+            continue;
+        }
+
+        LogRecord record;
+        std::memcpy(&record, data_.get() + position, sizeof(record));
+        if (record.format) {
+            f(record, data_.get() + position + sizeof(LogRecord));
+        }
+        tail += record.size;
+    }
+    tail_.store(tail, std::memory_order_release);
+}
+
+}
+
+namespace
+{
+
+void formatRecord(const details::LogRecord &record, const std::byte *payload, fmt::memory_buffer &out)
+{
+    if (record.category) {
+        fmt::format_to(std::back_inserter(out), "{} {}: ", toString(record.level), record.category->name());
+    }
+
+    const auto begin = out.size();
+    try {
+        record.format(payload, out);
+    } catch (const std::exception &e) {
+        out.resize(begin);
+        fmt::format_to(std::back_inserter(out), "<log format error: {}>", e.what());
+    }
+}
+
+}
+
+const char *toString(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::Trace:
+        return "trace";
+    case LogLevel::Debug:
+        return "debug";
+    case LogLevel::Info:
+        return "info";
+    case LogLevel::Warning:
+        return "warning";
+    case LogLevel::Error:
+        return "error";
+    case LogLevel::None:
+        break;
+    }
+    return "none";
+}
+
+Logger &Logger::shared()
+{
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : thread_{ [this]() { run(); } }
+{
+}
+
+Logger::~Logger()
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+void Logger::flush()
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    const auto ticket = ++flushRequested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [this, ticket]() { return flushDone_ >= ticket; });
+}
+
+bool Logger::setFile(const std::string &path)
+{
+    flush();
+
+    std::lock_guard<std::mutex> lock{ outputMutex_ };
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    if (!path.empty()) {
+        file_ = std::fopen(path.c_str(), "a");
+    }
+    return path.empty() || file_;
+}
+
+void Logger::setConsole(bool enabled)
+{
+    flush();
+
+    std::lock_guard<std::mutex> lock{ outputMutex_ };
+    console_ = enabled;
+}
+
+details::LogRing &Logger::threadRing()
+{
+    struct Local
+    {
+        std::shared_ptr<details::LogRing> ring;
+        ~Local()
+        {
+            if (ring) {
+                ring->closed = true;
+            }
+        }
+    };
+
+    thread_local Local local;
+    if (!local.ring) {
+        local.ring = std::make_shared<details::LogRing>(ringSize);
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        rings_.push_back(local.ring);
+    }
+    return *local.ring;
+}
+
+void Logger::writeOverflow(const details::LogRecord &record, const std::byte *payload)
+{
+    fmt::memory_buffer text;
+    formatRecord(record, payload, text);
+
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    overflow_.emplace_back(record.time, std::string{ text.data(), text.size() });
+    wake_.notify_one();
+}
+
+void Logger::run()
+{
+    fmt::memory_buffer text;
+    std::vector<Message> messages;
+    std::vector<std::shared_ptr<details::LogRing>> rings;
+    std::vector<std::pair<int64_t, std::string>> overflow;
+    std::vector<const details::LogRing*> drained;
+
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    for (;;) {
+        // Batches of what was logged during the interval, flush and overflow cut it short.
+        wake_.wait_for(lock, std::chrono::milliseconds{ 10 }, [this]() {
+            return stopping_ || flushRequested_ != flushDone_ || !overflow_.empty();
+        });
+        const auto flushTicket = flushRequested_;
+        const auto stopping = stopping_;
+        rings = rings_;
+        overflow.swap(overflow_);
+        lock.unlock();
+
+        text.clear();
+        messages.clear();
+        drained.clear();
+        for (const auto &ring : rings) {
+            // Nothing is logged to a closed ring after the pass that sees it closed.
+            const auto closed = ring->closed.load(std::memory_order_acquire);
+            ring->consume([&text, &messages](const details::LogRecord &record, const std::byte *payload) {
+                const auto begin = text.size();
+                formatRecord(record, payload, text);
+                messages.push_back({ record.time, begin, text.size() });
+            });
+            if (closed) {
+                drained.push_back(ring.get());
+            }
+        }
+        for (const auto &[time, message] : overflow) {
+            const auto begin = text.size();
+            text.append(message.data(), message.data() + message.size());
+            messages.push_back({ time, begin, text.size() });
+        }
+        overflow.clear();
+        rings.clear();
+
+        // Messages of one thread are in order already, stable sorting merges the threads.
+        std::stable_sort(messages.begin(), messages.end(), [](const Message &a, const Message &b) {
+            return a.time < b.time;
+        });
+        output(text, messages);
+
+        lock.lock();
+        if (!drained.empty()) {
+            std::erase_if(rings_, [&drained](const auto &ring) {
+                return std::find(drained.begin(), drained.end(), ring.get()) != drained.end();
+            });
+        }
+        flushDone_ = flushTicket;
+        flushed_.notify_all();
+
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+void Logger::output(const fmt::memory_buffer &text, const std::vector<Message> &messages)
+{
+    std::lock_guard<std::mutex> lock{ outputMutex_ };
+    if (messages.empty() || (!console_ && !file_)) {
+        return;
+    }
+
+    // Steady clock times of the records converted to wall clock ones.
+    const auto steadyNow = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto systemNow = std::chrono::system_clock::now();
+
+    fmt::memory_buffer batch;
+    std::time_t second = -1;
+    char stamp[16] = "";
+    for (const auto &message : messages) {
+        const auto age = std::chrono::steady_clock::duration{ steadyNow - message.time };
+        const auto time = std::chrono::system_clock::to_time_t(
+            systemNow - std::chrono::duration_cast<std::chrono::system_clock::duration>(age));
+        if (time != second) {
+            second = time;
+            std::tm local;
+#ifdef _WIN32
+            localtime_s(&local, &time);
+#else
+            localtime_r(&time, &local);
+#endif
+            std::strftime(stamp, sizeof(stamp), "%H:%M:%S", &local);
+        }
+
+        const std::string_view line{ text.data() + message.begin, message.end - message.begin };
+#ifdef __ANDROID__
+        if (console_) {
+            __android_log_print(ANDROID_LOG_INFO, "gmt", "%s: %.*s", stamp, static_cast<int>(line.size()), line.data());
+        }
+#endif
+        fmt::format_to(std::back_inserter(batch), "{}: {}\n", stamp, line);
+    }
+
+#ifndef __ANDROID__
+    if (console_) {
+        std::fwrite(batch.data(), 1, batch.size(), stdout);
+        std::fflush(stdout);
+    }
+#endif
+    if (file_) {
+        std::fwrite(batch.data(), 1, batch.size(), file_);
+        std::fflush(file_);
+    }
+}
+
+}
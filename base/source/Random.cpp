@@ -0,0 +1,182 @@
+#include "gmt/Random.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace gmt
+{
+
+namespace
+{
+
+// Advance by 2^128 and 2^192 steps.
+constexpr uint64_t jumpPolynomial[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+constexpr uint64_t longJumpPolynomial[] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+
+uint64_t splitMix64(uint64_t &x)
+{
+    auto z = (x += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// One xoshiro256** step of every lane, writes one output per lane.
+void step(uint64_t (&s)[4][RandomEngine::lanes], uint64_t *destination)
+{
+    for (size_t i = 0; i < RandomEngine::lanes; i++) {
+        // * 5 and * 9 as shifts, SSE and AVX2 have no 64 bit multiply.
+        const auto x = rotl((s[1][i] << 2) + s[1][i], 7);
+        destination[i] = (x << 3) + x;
+
+        const auto t = s[1][i] << 17;
+        s[2][i] ^= s[0][i];
+        s[3][i] ^= s[1][i];
+        s[1][i] ^= s[2][i];
+        s[0][i] ^= s[3][i];
+        s[2][i] ^= t;
+        s[3][i] = rotl(s[3][i], 45);
+    }
+}
+
+void jumpLanes(uint64_t (&s)[4][RandomEngine::lanes], const uint64_t (&polynomial)[4])
+{
+    uint64_t jumped[4][RandomEngine::lanes] = {};
+    uint64_t discarded[RandomEngine::lanes];
+    for (const auto word : polynomial) {
+        for (int bit = 0; bit < 64; bit++) {
+            if (word & (uint64_t{ 1 } << bit)) {
+                for (size_t w = 0; w < 4; w++) {
+                    for (size_t i = 0; i < RandomEngine::lanes; i++) {
+                        jumped[w][i] ^= s[w][i];
+                    }
+                }
+            }
+            step(s, discarded);
+        }
+    }
+    std::copy(&jumped[0][0], &jumped[0][0] + 4 * RandomEngine::lanes, &s[0][0]);
+}
+
+std::atomic<uint64_t> &baseSeed()
+{
+    static std::atomic<uint64_t> seed{ [] {
+        std::random_device device;
+        return (uint64_t{ device() } << 32) | device();
+    }() };
+    return seed;
+}
+
+std::atomic<uint64_t> threadsCount{ 0 };
+
+}
+
+RandomEngine::RandomEngine(uint64_t seed)
+{
+    // Every lane starts from the seeded state, lane i then needs i jumps.
+    for (size_t w = 0; w < 4; w++) {
+        const auto word = splitMix64(seed);
+        for (size_t i = 0; i < lanes; i++) {
+            state_[w][i] = word;
+        }
+    }
+
+    // Lane 0 keeps the seeded state, the jumps run on a copy.
+    uint64_t jumped[4][lanes];
+    std::copy(&state_[0][0], &state_[0][0] + 4 * lanes, &jumped[0][0]);
+    for (size_t i = 1; i < lanes; i++) {
+        jumpLanes(jumped, jumpPolynomial);
+        for (size_t w = 0; w < 4; w++) {
+            state_[w][i] = jumped[w][i];
+        }
+    }
+}
+
+void RandomEngine::jump()
+{
+    jumpLanes(state_, longJumpPolynomial);
+    next_ = blockSize;
+}
+
+void RandomEngine::fill(float *destination, size_t count, float min, float max)
+{
+    const auto scale = (max - min) * 0x1.0p-24f;
+    alignas(64) uint64_t values[blockSize];
+    for (size_t i = 0; i < count; i += blockSize) {
+        generate(values);
+        const auto n = std::min(blockSize, count - i);
+        for (size_t j = 0; j < n; j++) {
+            // Through int32, converting uint64 to float doesn't vectorize.
+            destination[i + j] = min + static_cast<float>(static_cast<int32_t>(values[j] >> 40)) * scale;
+        }
+    }
+}
+
+void RandomEngine::fill(int32_t *destination, size_t count, int32_t min, int32_t max)
+{
+    const auto range = static_cast<uint64_t>(int64_t{ max } - int64_t{ min }) + 1;
+    alignas(64) uint64_t values[blockSize];
+    for (size_t i = 0; i < count; i += blockSize) {
+        generate(values);
+        const auto n = std::min(blockSize, count - i);
+        for (size_t j = 0; j < n; j++) {
+            destination[i + j] = static_cast<int32_t>(min + static_cast<int64_t>(((values[j] >> 32) * range) >> 32));
+        }
+    }
+}
+
+void RandomEngine::fill(glm::vec2 *destination, size_t count, const glm::vec2 &min, const glm::vec2 &max)
+{
+    static_assert(sizeof(glm::vec2) == 2 * sizeof(float));
+    auto *values = reinterpret_cast<float*>(destination);
+    fill(values, 2 * count, 0.0f, 1.0f);
+
+    const auto size = max - min;
+    for (size_t i = 0; i < count; i++) {
+        values[2 * i] = min.x + values[2 * i] * size.x;
+        values[2 * i + 1] = min.y + values[2 * i + 1] * size.y;
+    }
+}
+
+void RandomEngine::refill()
+{
+    generate(block_);
+    next_ = 0;
+}
+
+void RandomEngine::generate(uint64_t *destination)
+{
+    // A local copy can't alias destination.
+    uint64_t state[4][lanes];
+    std::copy(&state_[0][0], &state_[0][0] + 4 * lanes, &state[0][0]);
+    for (size_t i = 0; i < blockSize; i += lanes) {
+        step(state, destination + i);
+    }
+    std::copy(&state[0][0], &state[0][0] + 4 * lanes, &state_[0][0]);
+}
+
+namespace details
+{
+
+RandomEngine &createThreadRandomEngine()
+{
+    thread_local RandomEngine engine{ baseSeed().load() + threadsCount.fetch_add(1) * 0x9e3779b97f4a7c15 };
+    return engine;
+}
+
+}
+
+void setRandomSeed(uint64_t seed)
+{
+    auto &engine = threadRandomEngine();
+    baseSeed() = seed;
+    threadsCount = 1;
+    engine = RandomEngine{ seed };
+}
+
+}
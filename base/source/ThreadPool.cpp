@@ -0,0 +1,66 @@
+#include "gmt/ThreadPool.h"
+
+namespace gmt
+{
+
+unsigned ThreadPool::defaultThreadsCount()
+{
+    const auto hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+ThreadPool::ThreadPool(unsigned threadsCount)
+{
+    threads_.reserve(threadsCount);
+    for (unsigned i = 0; i < threadsCount; i++) {
+        threads_.emplace_back([this]() { run(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        stopping_ = true;
+    }
+    condition_.notify_all();
+
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::post(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::run()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}
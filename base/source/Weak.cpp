@@ -5,3 +5,125 @@
 //
 
 #include "gmt/Weak.h"
+
+#include <cstddef>
+#include <mutex>
+
+namespace gmt
+{
+
+namespace details
+{
+
+namespace
+{
+
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+// Blocks per slab and the most blocks a thread keeps, beyond that half of them go back
+// to the shared list.
+constexpr size_t slabBlocks = 256;
+constexpr size_t cachedBlocks = 512;
+
+// Intentionally leaked, control blocks may be released by static destructors.
+struct Shared
+{
+    std::mutex mutex;
+    FreeBlock *head{ nullptr };
+};
+
+Shared &shared()
+{
+    static auto *instance = new Shared;
+    return *instance;
+}
+
+struct Cache
+{
+    FreeBlock *head{ nullptr };
+    size_t count{ 0 };
+
+    ~Cache() { giveBack(count); }
+
+    // Moves count blocks to the shared list.
+    void giveBack(size_t blocks)
+    {
+        if (!blocks) {
+            return;
+        }
+
+        auto *first = head;
+        auto *last = head;
+        for (size_t i = 1; i < blocks; i++) {
+            last = last->next;
+        }
+        head = last->next;
+        count -= blocks;
+
+        auto &pool = shared();
+        std::lock_guard<std::mutex> lock{ pool.mutex };
+        last->next = pool.head;
+        pool.head = first;
+    }
+
+    // Takes a batch from the shared list or a new slab.
+    void refill()
+    {
+        {
+            auto &pool = shared();
+            std::lock_guard<std::mutex> lock{ pool.mutex };
+            while (pool.head && count < slabBlocks) {
+                auto *block = pool.head;
+                pool.head = block->next;
+                block->next = head;
+                head = block;
+                count += 1;
+            }
+        }
+
+        if (!count) {
+            auto *slab = static_cast<std::byte*>(::operator new(slabBlocks * ControlBlockPool::blockSize));
+            for (size_t i = 0; i < slabBlocks; i++) {
+                auto *block = reinterpret_cast<FreeBlock*>(slab + i * ControlBlockPool::blockSize);
+                block->next = head;
+                head = block;
+            }
+            count = slabBlocks;
+        }
+    }
+};
+
+thread_local Cache cache;
+
+}
+
+void *ControlBlockPool::allocate()
+{
+    if (!cache.head) {
+        cache.refill();
+    }
+
+    auto *block = cache.head;
+    cache.head = block->next;
+    cache.count -= 1;
+    return block;
+}
+
+void ControlBlockPool::deallocate(void *block)
+{
+    auto *freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = cache.head;
+    cache.head = freeBlock;
+    cache.count += 1;
+
+    if (cache.count > cachedBlocks) {
+        cache.giveBack(cachedBlocks / 2);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,545 @@
+#include "gmt/math/Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtx/norm.hpp>
+
+namespace gmt
+{
+
+namespace
+{
+
+glm::vec3 transformPoint(const glm::mat4 &m, const glm::vec3 &p)
+{
+    return glm::vec3(m * glm::vec4(p, 1.0f));
+}
+
+glm::mat3 abs(const glm::mat3 &m)
+{
+    return glm::mat3(glm::abs(m[0]), glm::abs(m[1]), glm::abs(m[2]));
+}
+
+}
+
+Aabb Aabb::fromCenterExtents(const glm::vec3 &center, const glm::vec3 &extents)
+{
+    return Aabb{ center - extents, center + extents };
+}
+
+Aabb Aabb::fromPoints(const glm::vec3 *points, size_t count)
+{
+    Aabb result;
+    for (size_t i = 0; i < count; i++) {
+        result.grow(points[i]);
+    }
+    return result;
+}
+
+float Aabb::area() const
+{
+    if (empty()) {
+        return 0.0f;
+    }
+    const auto d = size();
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+void Aabb::grow(const glm::vec3 &p)
+{
+    min = glm::min(min, p);
+    max = glm::max(max, p);
+}
+
+void Aabb::grow(const Aabb &box)
+{
+    min = glm::min(min, box.min);
+    max = glm::max(max, box.max);
+}
+
+Aabb Aabb::merged(const Aabb &box) const
+{
+    return Aabb{ glm::min(min, box.min), glm::max(max, box.max) };
+}
+
+Aabb Aabb::transformed(const glm::mat4 &m) const
+{
+    if (empty()) {
+        return *this;
+    }
+
+    // Arvo: the new extents are the old ones projected on the absolute basis vectors.
+    return fromCenterExtents(transformPoint(m, center()), abs(glm::mat3(m)) * extents());
+}
+
+bool Aabb::contains(const glm::vec3 &p) const
+{
+    return glm::all(glm::greaterThanEqual(p, min)) && glm::all(glm::lessThanEqual(p, max));
+}
+
+bool Aabb::contains(const Aabb &box) const
+{
+    return glm::all(glm::greaterThanEqual(box.min, min)) && glm::all(glm::lessThanEqual(box.max, max));
+}
+
+bool Aabb::contains(const Sphere &sphere) const
+{
+    return contains(sphere.bounds());
+}
+
+bool Aabb::overlaps(const Aabb &box) const
+{
+    return glm::all(glm::lessThanEqual(min, box.max)) && glm::all(glm::greaterThanEqual(max, box.min));
+}
+
+bool Aabb::overlaps(const Sphere &sphere) const
+{
+    const auto closest = glm::clamp(sphere.center, min, max);
+    return glm::length2(closest - sphere.center) <= sphere.radius * sphere.radius;
+}
+
+bool Aabb::outside(const Plane &plane) const
+{
+    const auto r = glm::dot(extents(), glm::abs(plane.normal()));
+    return plane.calculateSignedDistance(center()) < -r;
+}
+
+Sphere Sphere::fromAabb(const Aabb &box)
+{
+    if (box.empty()) {
+        return Sphere{};
+    }
+    return Sphere{ box.center(), glm::length(box.extents()) };
+}
+
+Sphere Sphere::fromPoints(const glm::vec3 *points, size_t count)
+{
+    if (count == 0) {
+        return Sphere{};
+    }
+
+    const auto farthest = [points, count](const glm::vec3 &from) {
+        size_t result = 0;
+        for (size_t i = 1; i < count; i++) {
+            if (glm::length2(points[i] - from) > glm::length2(points[result] - from)) {
+                result = i;
+            }
+        }
+        return points[result];
+    };
+
+    const auto a = farthest(points[0]);
+    const auto b = farthest(a);
+
+    Sphere result{ (a + b) * 0.5f, glm::length(b - a) * 0.5f };
+    for (size_t i = 0; i < count; i++) {
+        result.grow(points[i]);
+    }
+    return result;
+}
+
+void Sphere::grow(const glm::vec3 &p)
+{
+    grow(Sphere{ p, 0.0f });
+}
+
+void Sphere::grow(const Sphere &sphere)
+{
+    if (sphere.radius < 0.0f) {
+        return;
+    }
+    if (radius < 0.0f) {
+        *this = sphere;
+        return;
+    }
+
+    const auto d = glm::length(sphere.center - center);
+    if (d + sphere.radius <= radius) {
+        return;
+    }
+    if (d + radius <= sphere.radius) {
+        *this = sphere;
+        return;
+    }
+
+    const auto r = (d + radius + sphere.radius) * 0.5f;
+    center += (sphere.center - center) * ((r - radius) / d);
+    radius = r;
+}
+
+Sphere Sphere::merged(const Sphere &sphere) const
+{
+    auto result = *this;
+    result.grow(sphere);
+    return result;
+}
+
+Sphere Sphere::transformed(const glm::mat4 &m) const
+{
+    const auto scale2 = std::max({ glm::length2(glm::vec3(m[0])), glm::length2(glm::vec3(m[1])),
+                                   glm::length2(glm::vec3(m[2])) });
+    return Sphere{ transformPoint(m, center), radius * std::sqrt(scale2) };
+}
+
+bool Sphere::contains(const glm::vec3 &p) const
+{
+    return glm::length2(p - center) <= radius * radius;
+}
+
+bool Sphere::contains(const Sphere &sphere) const
+{
+    return glm::length(sphere.center - center) + sphere.radius <= radius;
+}
+
+bool Sphere::contains(const Aabb &box) const
+{
+    const auto farthest = glm::max(glm::abs(box.min - center), glm::abs(box.max - center));
+    return glm::length2(farthest) <= radius * radius;
+}
+
+bool Sphere::overlaps(const Sphere &sphere) const
+{
+    const auto r = radius + sphere.radius;
+    return glm::length2(sphere.center - center) <= r * r;
+}
+
+bool Sphere::outside(const Plane &plane) const
+{
+    return plane.calculateSignedDistance(center) < -radius;
+}
+
+Obb Obb::fromAabb(const Aabb &box, const glm::mat4 &m)
+{
+    return Obb{ box.center(), box.extents(), glm::mat3{ 1.0f } }.transformed(m);
+}
+
+Obb Obb::transformed(const glm::mat4 &m) const
+{
+    Obb result{ transformPoint(m, center), extents, axes };
+
+    const glm::mat3 linear{ m };
+    for (int i = 0; i < 3; i++) {
+        const auto axis = linear * axes[i];
+        const auto length = glm::length(axis);
+        if (length > 0.0f) {
+            result.axes[i] = axis / length;
+        }
+        result.extents[i] = extents[i] * length;
+    }
+    return result;
+}
+
+Aabb Obb::bounds() const
+{
+    return Aabb::fromCenterExtents(center, abs(axes) * extents);
+}
+
+bool Obb::contains(const glm::vec3 &p) const
+{
+    const auto d = p - center;
+    for (int i = 0; i < 3; i++) {
+        if (std::abs(glm::dot(d, axes[i])) > extents[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Obb::overlaps(const Obb &box) const
+{
+    // Separating axis test over the 15 candidate axes (Gottschalk).
+    constexpr float epsilon = 1.0e-6f;
+
+    float r[3][3];
+    float absR[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i][j] = glm::dot(axes[i], box.axes[j]);
+            absR[i][j] = std::abs(r[i][j]) + epsilon;
+        }
+    }
+
+    const auto d = box.center - center;
+    const float t[3] = { glm::dot(d, axes[0]), glm::dot(d, axes[1]), glm::dot(d, axes[2]) };
+    const auto &a = extents;
+    const auto &b = box.extents;
+
+    for (int i = 0; i < 3; i++) {
+        const auto rb = b[0] * absR[i][0] + b[1] * absR[i][1] + b[2] * absR[i][2];
+        if (std::abs(t[i]) > a[i] + rb) {
+            return false;
+        }
+    }
+
+    for (int j = 0; j < 3; j++) {
+        const auto ra = a[0] * absR[0][j] + a[1] * absR[1][j] + a[2] * absR[2][j];
+        if (std::abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > ra + b[j]) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        const auto i1 = (i + 1) % 3;
+        const auto i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; j++) {
+            const auto j1 = (j + 1) % 3;
+            const auto j2 = (j + 2) % 3;
+            const auto ra = a[i1] * absR[i2][j] + a[i2] * absR[i1][j];
+            const auto rb = b[j1] * absR[i][j2] + b[j2] * absR[i][j1];
+            if (std::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Obb::overlaps(const Sphere &sphere) const
+{
+    return glm::length2(closestPoint(sphere.center) - sphere.center) <= sphere.radius * sphere.radius;
+}
+
+bool Obb::outside(const Plane &plane) const
+{
+    const auto n = plane.normal();
+    const auto r = extents.x * std::abs(glm::dot(n, axes[0]))
+        + extents.y * std::abs(glm::dot(n, axes[1]))
+        + extents.z * std::abs(glm::dot(n, axes[2]));
+    return plane.calculateSignedDistance(center) < -r;
+}
+
+glm::vec3 Obb::closestPoint(const glm::vec3 &p) const
+{
+    const auto d = p - center;
+    auto result = center;
+    for (int i = 0; i < 3; i++) {
+        result += axes[i] * glm::clamp(glm::dot(d, axes[i]), -extents[i], extents[i]);
+    }
+    return result;
+}
+
+void AabbArray::resize(size_t size)
+{
+    for (auto *v : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ }) {
+        v->resize(size);
+    }
+}
+
+void AabbArray::push_back(const Aabb &box)
+{
+    resize(size() + 1);
+    set(size() - 1, box);
+}
+
+void AabbArray::set(size_t i, const Aabb &box)
+{
+    minX[i] = box.min.x;
+    minY[i] = box.min.y;
+    minZ[i] = box.min.z;
+    maxX[i] = box.max.x;
+    maxY[i] = box.max.y;
+    maxZ[i] = box.max.z;
+}
+
+Aabb AabbArray::get(size_t i) const
+{
+    return Aabb{ { minX[i], minY[i], minZ[i] }, { maxX[i], maxY[i], maxZ[i] } };
+}
+
+void SphereArray::resize(size_t size)
+{
+    for (auto *v : { &x, &y, &z, &radius }) {
+        v->resize(size);
+    }
+}
+
+void SphereArray::push_back(const Sphere &sphere)
+{
+    resize(size() + 1);
+    set(size() - 1, sphere);
+}
+
+void SphereArray::set(size_t i, const Sphere &sphere)
+{
+    x[i] = sphere.center.x;
+    y[i] = sphere.center.y;
+    z[i] = sphere.center.z;
+    radius[i] = sphere.radius;
+}
+
+Sphere SphereArray::get(size_t i) const
+{
+    return Sphere{ { x[i], y[i], z[i] }, radius[i] };
+}
+
+namespace bounds
+{
+
+// The loops below only touch plain float arrays with no branches, so they are vectorized by the
+// compiler like the packet kernels in Ray.h.
+
+void transform(const AabbArray &boxes, const glm::mat4 &m, AabbArray *result)
+{
+    const auto count = boxes.size();
+    result->resize(count);
+
+    const auto *minX = boxes.minX.data();
+    const auto *minY = boxes.minY.data();
+    const auto *minZ = boxes.minZ.data();
+    const auto *maxX = boxes.maxX.data();
+    const auto *maxY = boxes.maxY.data();
+    const auto *maxZ = boxes.maxZ.data();
+    auto *outMinX = result->minX.data();
+    auto *outMinY = result->minY.data();
+    auto *outMinZ = result->minZ.data();
+    auto *outMaxX = result->maxX.data();
+    auto *outMaxY = result->maxY.data();
+    auto *outMaxZ = result->maxZ.data();
+
+    const auto a = abs(glm::mat3(m));
+    for (size_t i = 0; i < count; i++) {
+        const auto cx = (minX[i] + maxX[i]) * 0.5f;
+        const auto cy = (minY[i] + maxY[i]) * 0.5f;
+        const auto cz = (minZ[i] + maxZ[i]) * 0.5f;
+        const auto ex = (maxX[i] - minX[i]) * 0.5f;
+        const auto ey = (maxY[i] - minY[i]) * 0.5f;
+        const auto ez = (maxZ[i] - minZ[i]) * 0.5f;
+
+        const auto x = m[0][0] * cx + m[1][0] * cy + m[2][0] * cz + m[3][0];
+        const auto y = m[0][1] * cx + m[1][1] * cy + m[2][1] * cz + m[3][1];
+        const auto z = m[0][2] * cx + m[1][2] * cy + m[2][2] * cz + m[3][2];
+        const auto rx = a[0][0] * ex + a[1][0] * ey + a[2][0] * ez;
+        const auto ry = a[0][1] * ex + a[1][1] * ey + a[2][1] * ez;
+        const auto rz = a[0][2] * ex + a[1][2] * ey + a[2][2] * ez;
+
+        outMinX[i] = x - rx;
+        outMinY[i] = y - ry;
+        outMinZ[i] = z - rz;
+        outMaxX[i] = x + rx;
+        outMaxY[i] = y + ry;
+        outMaxZ[i] = z + rz;
+    }
+}
+
+void transform(const SphereArray &spheres, const glm::mat4 &m, SphereArray *result)
+{
+    const auto count = spheres.size();
+    result->resize(count);
+
+    const auto *x = spheres.x.data();
+    const auto *y = spheres.y.data();
+    const auto *z = spheres.z.data();
+    const auto *radius = spheres.radius.data();
+    auto *outX = result->x.data();
+    auto *outY = result->y.data();
+    auto *outZ = result->z.data();
+    auto *outRadius = result->radius.data();
+
+    const auto scale = std::sqrt(std::max({ glm::length2(glm::vec3(m[0])), glm::length2(glm::vec3(m[1])),
+                                            glm::length2(glm::vec3(m[2])) }));
+    for (size_t i = 0; i < count; i++) {
+        const auto cx = x[i];
+        const auto cy = y[i];
+        const auto cz = z[i];
+        outX[i] = m[0][0] * cx + m[1][0] * cy + m[2][0] * cz + m[3][0];
+        outY[i] = m[0][1] * cx + m[1][1] * cy + m[2][1] * cz + m[3][1];
+        outZ[i] = m[0][2] * cx + m[1][2] * cy + m[2][2] * cz + m[3][2];
+        outRadius[i] = radius[i] * scale;
+    }
+}
+
+void overlaps(const AabbArray &boxes, const Aabb &box, uint8_t *results)
+{
+    const auto count = boxes.size();
+    const auto *minX = boxes.minX.data();
+    const auto *minY = boxes.minY.data();
+    const auto *minZ = boxes.minZ.data();
+    const auto *maxX = boxes.maxX.data();
+    const auto *maxY = boxes.maxY.data();
+    const auto *maxZ = boxes.maxZ.data();
+
+    for (size_t i = 0; i < count; i++) {
+        results[i] = static_cast<uint8_t>(
+            (minX[i] <= box.max.x) & (maxX[i] >= box.min.x)
+            & (minY[i] <= box.max.y) & (maxY[i] >= box.min.y)
+            & (minZ[i] <= box.max.z) & (maxZ[i] >= box.min.z));
+    }
+}
+
+void overlaps(const SphereArray &spheres, const Sphere &sphere, uint8_t *results)
+{
+    const auto count = spheres.size();
+    const auto *x = spheres.x.data();
+    const auto *y = spheres.y.data();
+    const auto *z = spheres.z.data();
+    const auto *radius = spheres.radius.data();
+
+    for (size_t i = 0; i < count; i++) {
+        const auto dx = x[i] - sphere.center.x;
+        const auto dy = y[i] - sphere.center.y;
+        const auto dz = z[i] - sphere.center.z;
+        const auto r = radius[i] + sphere.radius;
+        results[i] = static_cast<uint8_t>(dx * dx + dy * dy + dz * dz <= r * r);
+    }
+}
+
+void intersectsPlanes(const AabbArray &boxes, const Plane *planes, size_t planesCount, uint8_t *results)
+{
+    const auto count = boxes.size();
+    const auto *minX = boxes.minX.data();
+    const auto *minY = boxes.minY.data();
+    const auto *minZ = boxes.minZ.data();
+    const auto *maxX = boxes.maxX.data();
+    const auto *maxY = boxes.maxY.data();
+    const auto *maxZ = boxes.maxZ.data();
+
+    std::fill(results, results + count, uint8_t{ 1 });
+    for (size_t p = 0; p < planesCount; p++) {
+        if (!planes[p]) {
+            continue;
+        }
+        const auto n = planes[p].normal();
+        const auto an = glm::abs(n);
+        const auto d = glm::dot(n, planes[p].origin());
+
+        for (size_t i = 0; i < count; i++) {
+            const auto cx = (minX[i] + maxX[i]) * 0.5f;
+            const auto cy = (minY[i] + maxY[i]) * 0.5f;
+            const auto cz = (minZ[i] + maxZ[i]) * 0.5f;
+            const auto r = (maxX[i] - minX[i]) * 0.5f * an.x
+                + (maxY[i] - minY[i]) * 0.5f * an.y
+                + (maxZ[i] - minZ[i]) * 0.5f * an.z;
+            const auto distance = n.x * cx + n.y * cy + n.z * cz - d;
+            results[i] &= static_cast<uint8_t>(distance >= -r);
+        }
+    }
+}
+
+void intersectsPlanes(const SphereArray &spheres, const Plane *planes, size_t planesCount, uint8_t *results)
+{
+    const auto count = spheres.size();
+    const auto *x = spheres.x.data();
+    const auto *y = spheres.y.data();
+    const auto *z = spheres.z.data();
+    const auto *radius = spheres.radius.data();
+
+    std::fill(results, results + count, uint8_t{ 1 });
+    for (size_t p = 0; p < planesCount; p++) {
+        if (!planes[p]) {
+            continue;
+        }
+        const auto n = planes[p].normal();
+        const auto d = glm::dot(n, planes[p].origin());
+
+        for (size_t i = 0; i < count; i++) {
+            const auto distance = n.x * x[i] + n.y * y[i] + n.z * z[i] - d;
+            results[i] &= static_cast<uint8_t>(distance >= -radius[i]);
+        }
+    }
+}
+
+}
+
+}
@@ -0,0 +1,349 @@
+#include "gmt/math/Bvh.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "gmt/ThreadPool.h"
+
+namespace gmt
+{
+
+namespace
+{
+
+// Below this depth splits fall back to the median, it bounds the traversal stack.
+constexpr int maxDepth = 32;
+constexpr int stackSize = 64;
+constexpr uint32_t invalidTriangle = std::numeric_limits<uint32_t>::max();
+
+struct Primitive
+{
+    Aabb bounds;
+    glm::vec3 centroid;
+};
+
+struct Bin
+{
+    Aabb bounds;
+    uint32_t count{ 0 };
+};
+
+template <typename F>
+void forEach(ThreadPool *pool, size_t count, size_t grain, F &&f)
+{
+    if (pool) {
+        pool->parallelFor(count, grain, std::forward<F>(f));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            f(i);
+        }
+    }
+}
+
+class Builder
+{
+public:
+    Builder(std::vector<Primitive> primitives, const BvhBuildOptions &options)
+        : primitives_{ std::move(primitives) }
+        , options_{ options }
+        , order_(primitives_.size())
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(order_.size()); i++) {
+            order_[i] = i;
+        }
+    }
+
+    const std::vector<uint32_t> &order() const { return order_; }
+
+    // Leaves reference ranges of order().
+    void build(uint32_t begin, uint32_t end, int depth, std::vector<BvhNode> *nodes)
+    {
+        Aabb bounds;
+        Aabb centroids;
+        for (auto i = begin; i < end; i++) {
+            const auto &primitive = primitives_[order_[i]];
+            bounds.grow(primitive.bounds);
+            centroids.grow(primitive.centroid);
+        }
+
+        const auto index = nodes->size();
+        nodes->push_back(BvhNode{ bounds.min, begin, bounds.max, end - begin });
+
+        if (end - begin <= static_cast<uint32_t>(options_.maxLeafSize)) {
+            return;
+        }
+
+        const auto middle = split(begin, end, centroids, depth);
+        (*nodes)[index].count = 0;
+
+        if (options_.pool && end - begin >= options_.parallelThreshold) {
+            std::vector<BvhNode> children[2];
+            options_.pool->parallelFor(2, 1, [&](size_t i) {
+                if (i == 0) {
+                    build(begin, middle, depth + 1, &children[0]);
+                } else {
+                    build(middle, end, depth + 1, &children[1]);
+                }
+            });
+
+            append(children[0], nodes);
+            (*nodes)[index].offset = static_cast<uint32_t>(nodes->size());
+            append(children[1], nodes);
+        } else {
+            build(begin, middle, depth + 1, nodes);
+            (*nodes)[index].offset = static_cast<uint32_t>(nodes->size());
+            build(middle, end, depth + 1, nodes);
+        }
+    }
+
+private:
+    std::vector<Primitive> primitives_;
+    BvhBuildOptions options_;
+    std::vector<uint32_t> order_;
+
+    static void append(const std::vector<BvhNode> &subtree, std::vector<BvhNode> *nodes)
+    {
+        const auto base = static_cast<uint32_t>(nodes->size());
+        for (auto node : subtree) {
+            if (!node.leaf()) {
+                node.offset += base;
+            }
+            nodes->push_back(node);
+        }
+    }
+
+    uint32_t split(uint32_t begin, uint32_t end, const Aabb &centroids, int depth)
+    {
+        const auto binsCount = options_.binsCount;
+        std::vector<Bin> bins(binsCount);
+        std::vector<float> leftCosts(binsCount);
+
+        auto bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        int bestBin = 0;
+
+        for (int axis = 0; axis < 3 && depth < maxDepth; axis++) {
+            const auto extent = centroids.max[axis] - centroids.min[axis];
+            if (extent <= 0.0f) {
+                continue;
+            }
+
+            std::fill(bins.begin(), bins.end(), Bin{});
+            const auto scale = binsCount / extent;
+            for (auto i = begin; i < end; i++) {
+                const auto &primitive = primitives_[order_[i]];
+                const auto b = std::min(binsCount - 1,
+                    static_cast<int>((primitive.centroid[axis] - centroids.min[axis]) * scale));
+                bins[b].count += 1;
+                bins[b].bounds.grow(primitive.bounds);
+            }
+
+            // Cost of splitting after bin i is leftCount * leftArea + rightCount * rightArea.
+            Aabb left;
+            uint32_t leftCount = 0;
+            for (int i = 0; i < binsCount - 1; i++) {
+                left.grow(bins[i].bounds);
+                leftCount += bins[i].count;
+                leftCosts[i] = leftCount * left.area();
+            }
+
+            Aabb right;
+            uint32_t rightCount = 0;
+            for (int i = binsCount - 1; i > 0; i--) {
+                right.grow(bins[i].bounds);
+                rightCount += bins[i].count;
+                const auto cost = leftCosts[i - 1] + rightCount * right.area();
+                if (rightCount > 0 && rightCount < end - begin && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i - 1;
+                }
+            }
+        }
+
+        if (bestAxis >= 0) {
+            const auto scale = binsCount / (centroids.max[bestAxis] - centroids.min[bestAxis]);
+            const auto it = std::partition(order_.begin() + begin, order_.begin() + end, [&](uint32_t i) {
+                const auto b = std::min(binsCount - 1,
+                    static_cast<int>((primitives_[i].centroid[bestAxis] - centroids.min[bestAxis]) * scale));
+                return b <= bestBin;
+            });
+            return static_cast<uint32_t>(it - order_.begin());
+        }
+
+        // Every centroid falls into one bin or the tree is too deep: split in halves.
+        const auto extent = centroids.max - centroids.min;
+        const auto axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        const auto middle = begin + (end - begin) / 2;
+        std::nth_element(order_.begin() + begin, order_.begin() + middle, order_.begin() + end,
+            [&](uint32_t a, uint32_t b) { return primitives_[a].centroid[axis] < primitives_[b].centroid[axis]; });
+        return middle;
+    }
+};
+
+uint32_t packetsCount(uint32_t trianglesCount)
+{
+    return (trianglesCount + 3) / 4;
+}
+
+}
+
+Bvh::Bvh(const MeshView &mesh, const BvhBuildOptions &options)
+{
+    const auto trianglesCount = mesh.trianglesCount();
+    if (trianglesCount == 0) {
+        return;
+    }
+
+    std::vector<Primitive> primitives(trianglesCount);
+    forEach(options.pool, trianglesCount, 1024, [&mesh, &primitives](size_t i) {
+        auto &primitive = primitives[i];
+        for (size_t k = 0; k < 3; k++) {
+            primitive.bounds.grow(mesh.position(mesh.index(i * 3 + k)));
+        }
+        primitive.centroid = (primitive.bounds.min + primitive.bounds.max) * 0.5f;
+    });
+
+    Builder builder{ std::move(primitives), options };
+    nodes_.reserve(trianglesCount * 2 / std::max(options.maxLeafSize, 1) + 1);
+    builder.build(0, static_cast<uint32_t>(trianglesCount), 0, &nodes_);
+
+    const auto &order = builder.order();
+    for (auto &node : nodes_) {
+        if (!node.leaf()) {
+            continue;
+        }
+
+        const auto first = node.offset;
+        node.offset = static_cast<uint32_t>(packets_.size());
+        for (uint32_t k = 0; k < node.count; k += 4) {
+            TrianglePacket<4> packet;
+            for (int lane = 0; lane < 4; lane++) {
+                if (k + lane < node.count) {
+                    const auto triangle = order[first + k + lane];
+                    packet.set(lane,
+                        mesh.position(mesh.index(triangle * 3 + 0)),
+                        mesh.position(mesh.index(triangle * 3 + 1)),
+                        mesh.position(mesh.index(triangle * 3 + 2)));
+                    triangles_.push_back(triangle);
+                } else {
+                    packet.clear(lane);
+                    triangles_.push_back(invalidTriangle);
+                }
+            }
+            packets_.push_back(packet);
+        }
+    }
+}
+
+bool Bvh::intersect(const Ray &ray, BvhHit *hit, float tMax, ray::Culling culling) const
+{
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    struct Entry
+    {
+        uint32_t node;
+        float t;
+    };
+
+    Entry stack[stackSize];
+    int size = 0;
+
+    float t;
+    if (!ray::intersectsBox(ray, nodes_[0].min, nodes_[0].max, &t, tMax)) {
+        return false;
+    }
+    stack[size++] = Entry{ 0, t };
+
+    auto closest = tMax;
+    bool found = false;
+    while (size > 0) {
+        const auto entry = stack[--size];
+        if (entry.t >= closest) {
+            continue;
+        }
+
+        auto index = entry.node;
+        for (;;) {
+            const auto &node = nodes_[index];
+            if (node.leaf()) {
+                const auto end = node.offset + packetsCount(node.count);
+                for (auto p = node.offset; p < end; p++) {
+                    HitPacket<4> hits;
+                    hits.reset(closest);
+                    const auto mask = ray::intersectsTriangle(ray, packets_[p], &hits, culling);
+                    if (mask) {
+                        const auto lane = ray::closestLane(mask, hits);
+                        closest = hits.t[lane];
+                        *hit = BvhHit{ hits.t[lane], hits.u[lane], hits.v[lane], triangles_[p * 4 + lane] };
+                        found = true;
+                    }
+                }
+                break;
+            }
+
+            auto near = index + 1;
+            auto far = node.offset;
+            float tNear;
+            float tFar;
+            const auto hitNear = ray::intersectsBox(ray, nodes_[near].min, nodes_[near].max, &tNear, closest);
+            const auto hitFar = ray::intersectsBox(ray, nodes_[far].min, nodes_[far].max, &tFar, closest);
+            if (hitNear && hitFar) {
+                if (tFar < tNear) {
+                    std::swap(near, far);
+                    std::swap(tNear, tFar);
+                }
+                stack[size++] = Entry{ far, tFar };
+                index = near;
+            } else if (hitNear) {
+                index = near;
+            } else if (hitFar) {
+                index = far;
+            } else {
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+bool Bvh::occluded(const Ray &ray, float tMax, ray::Culling culling) const
+{
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    uint32_t stack[stackSize];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const auto &node = nodes_[stack[--size]];
+
+        float t;
+        if (!ray::intersectsBox(ray, node.min, node.max, &t, tMax)) {
+            continue;
+        }
+
+        if (node.leaf()) {
+            const auto end = node.offset + packetsCount(node.count);
+            for (auto p = node.offset; p < end; p++) {
+                HitPacket<4> hits;
+                hits.reset(tMax);
+                if (ray::intersectsTriangle(ray, packets_[p], &hits, culling)) {
+                    return true;
+                }
+            }
+        } else {
+            stack[size++] = node.offset;
+            stack[size++] = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+        }
+    }
+
+    return false;
+}
+
+}
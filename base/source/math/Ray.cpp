@@ -0,0 +1,76 @@
+#include "gmt/math/Ray.h"
+
+namespace gmt
+{
+
+namespace ray
+{
+
+bool intersectsTriangle(const Ray &ray, const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2,
+    RayHit *hit, float tMax, Culling culling)
+{
+    const auto e1 = p1 - p0;
+    const auto e2 = p2 - p0;
+    const auto p = glm::cross(ray.direction, e2);
+    const auto det = glm::dot(e1, p);
+
+    if (culling == Culling::BackFaces ? det <= details::rayEpsilon : std::abs(det) <= details::rayEpsilon) {
+        return false;
+    }
+
+    const auto invDet = 1.0f / det;
+    const auto s = ray.origin - p0;
+    const auto u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    const auto q = glm::cross(s, e1);
+    const auto v = glm::dot(ray.direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    const auto t = glm::dot(e2, q) * invDet;
+    if (t < 0.0f || t >= tMax) {
+        return false;
+    }
+
+    *hit = RayHit{ t, u, v };
+    return true;
+}
+
+bool intersectsBox(const Ray &ray, const glm::vec3 &min, const glm::vec3 &max, float *tNear, float tMax)
+{
+    const auto inv = details::safeInverse(ray.direction);
+    const auto nearCorner = glm::vec3{
+        inv.x >= 0.0f ? min.x : max.x,
+        inv.y >= 0.0f ? min.y : max.y,
+        inv.z >= 0.0f ? min.z : max.z
+    };
+    const auto farCorner = glm::vec3{
+        inv.x >= 0.0f ? max.x : min.x,
+        inv.y >= 0.0f ? max.y : min.y,
+        inv.z >= 0.0f ? max.z : min.z
+    };
+    const auto t0 = (nearCorner - ray.origin) * inv;
+    const auto t1 = (farCorner - ray.origin) * inv;
+
+    const auto enter = std::max(std::max(t0.x, t0.y), std::max(t0.z, 0.0f));
+    const auto exit = std::min(std::min(t1.x, t1.y), std::min(t1.z, tMax));
+    if (enter > exit) {
+        return false;
+    }
+
+    *tNear = enter;
+    return true;
+}
+
+bool intersectsBox(const Ray &ray, const Aabb &box, float *tNear, float tMax)
+{
+    return intersectsBox(ray, box.min, box.max, tNear, tMax);
+}
+
+}
+
+}
@@ -0,0 +1,375 @@
+#include "gmt/math/TransformHierarchy.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "gmt/ThreadPool.h"
+
+namespace gmt
+{
+
+namespace
+{
+
+constexpr uint32_t none = TransformHierarchy::none;
+
+// Nodes per parallel task.
+constexpr uint32_t parallelGrain = 1024;
+
+// Nodes composed together, the loops over them vectorize.
+constexpr uint32_t lanes = 8;
+
+const glm::mat4 identity{ 1.0f };
+
+template <typename T>
+void permuteArray(std::vector<T> *values, const std::vector<uint32_t> &order)
+{
+    std::vector<T> result(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        result[i] = (*values)[order[i]];
+    }
+    *values = std::move(result);
+}
+
+}
+
+TransformHierarchy::Node TransformHierarchy::create(Node parent)
+{
+    assert(parent == none || valid(parent));
+
+    Node node;
+    if (freeNodes_.empty()) {
+        node = static_cast<Node>(slots_.size());
+        slots_.push_back(none);
+    } else {
+        node = freeNodes_.back();
+        freeNodes_.pop_back();
+    }
+
+    const auto slot = static_cast<uint32_t>(nodes_.size());
+    const auto parentSlot = parent == none ? none : slots_[parent];
+    const auto depth = parent == none ? 0 : depths_[parentSlot] + 1;
+    slots_[node] = slot;
+    nodes_.push_back(node);
+    parents_.push_back(parentSlot);
+    depths_.push_back(depth);
+    positionX_.push_back(0.0f);
+    positionY_.push_back(0.0f);
+    positionZ_.push_back(0.0f);
+    rotationX_.push_back(0.0f);
+    rotationY_.push_back(0.0f);
+    rotationZ_.push_back(0.0f);
+    rotationW_.push_back(1.0f);
+    scaleX_.push_back(1.0f);
+    scaleY_.push_back(1.0f);
+    scaleZ_.push_back(1.0f);
+    world_.push_back(glm::mat4{ 1.0f });
+    dirty_.push_back(1);
+
+    // Appending to the deepest level or starting the next one keeps the order.
+    if (levels_.empty()) {
+        levels_.push_back(0);
+    }
+    const auto deepest = static_cast<uint32_t>(levels_.size()) - 2;
+    if (levels_.size() > 1 && depth == deepest) {
+        levels_.back()++;
+    } else if (depth == deepest + 1) {
+        levels_.push_back(slot + 1);
+    } else {
+        unsorted_ = true;
+    }
+    return node;
+}
+
+void TransformHierarchy::destroy(Node node)
+{
+    assert(valid(node));
+    if (unsorted_) {
+        sort();
+    }
+
+    // Parents come first, so one pass finds the whole subtree.
+    const auto root = slots_[node];
+    std::vector<uint8_t> removed(nodes_.size(), 0);
+    removed[root] = 1;
+    std::vector<uint32_t> order;
+    for (uint32_t slot = 0; slot < nodes_.size(); slot++) {
+        if (slot > root && parents_[slot] != none && removed[parents_[slot]]) {
+            removed[slot] = 1;
+        }
+        if (removed[slot]) {
+            slots_[nodes_[slot]] = none;
+            freeNodes_.push_back(nodes_[slot]);
+        } else {
+            order.push_back(slot);
+        }
+    }
+
+    permute(order);
+
+    levels_.assign(1, 0);
+    for (uint32_t slot = 0; slot < depths_.size(); slot++) {
+        if (depths_[slot] + 2 > levels_.size()) {
+            levels_.push_back(slot);
+        }
+        levels_.back() = slot + 1;
+    }
+}
+
+void TransformHierarchy::setParent(Node node, Node parent)
+{
+    assert(valid(node) && (parent == none || valid(parent)));
+
+    const auto slot = slots_[node];
+    const auto parentSlot = parent == none ? none : slots_[parent];
+    for (auto ancestor = parentSlot; ancestor != none; ancestor = parents_[ancestor]) {
+        assert(ancestor != slot && "A node can't be parented to its descendant");
+    }
+
+    parents_[slot] = parentSlot;
+    dirty_[slot] = 1;
+    unsorted_ = true;
+}
+
+TransformHierarchy::Node TransformHierarchy::getParent(Node node) const
+{
+    const auto parent = parents_[slots_[node]];
+    return parent == none ? none : nodes_[parent];
+}
+
+void TransformHierarchy::setPosition(Node node, const glm::vec3 &position)
+{
+    const auto slot = slots_[node];
+    positionX_[slot] = position.x;
+    positionY_[slot] = position.y;
+    positionZ_[slot] = position.z;
+    dirty_[slot] = 1;
+}
+
+void TransformHierarchy::setRotation(Node node, const glm::quat &rotation)
+{
+    const auto slot = slots_[node];
+    rotationX_[slot] = rotation.x;
+    rotationY_[slot] = rotation.y;
+    rotationZ_[slot] = rotation.z;
+    rotationW_[slot] = rotation.w;
+    dirty_[slot] = 1;
+}
+
+void TransformHierarchy::setScale(Node node, const glm::vec3 &scale)
+{
+    const auto slot = slots_[node];
+    scaleX_[slot] = scale.x;
+    scaleY_[slot] = scale.y;
+    scaleZ_[slot] = scale.z;
+    dirty_[slot] = 1;
+}
+
+void TransformHierarchy::setLocal(Node node, const glm::vec3 &position, const glm::quat &rotation,
+    const glm::vec3 &scale)
+{
+    setPosition(node, position);
+    setRotation(node, rotation);
+    setScale(node, scale);
+}
+
+glm::vec3 TransformHierarchy::getPosition(Node node) const
+{
+    const auto slot = slots_[node];
+    return { positionX_[slot], positionY_[slot], positionZ_[slot] };
+}
+
+glm::quat TransformHierarchy::getRotation(Node node) const
+{
+    const auto slot = slots_[node];
+    return glm::quat{ rotationW_[slot], rotationX_[slot], rotationY_[slot], rotationZ_[slot] };
+}
+
+glm::vec3 TransformHierarchy::getScale(Node node) const
+{
+    const auto slot = slots_[node];
+    return { scaleX_[slot], scaleY_[slot], scaleZ_[slot] };
+}
+
+size_t TransformHierarchy::update(ThreadPool *pool, size_t parallelThreshold)
+{
+    if (unsorted_) {
+        sort();
+    }
+
+    for (size_t level = 0; level + 1 < levels_.size(); level++) {
+        const auto begin = levels_[level];
+        const auto end = levels_[level + 1];
+        if (pool && end - begin >= parallelThreshold) {
+            pool->parallelFor((end - begin + parallelGrain - 1) / parallelGrain, 1, [this, begin, end](size_t chunk) {
+                const auto chunkBegin = begin + static_cast<uint32_t>(chunk) * parallelGrain;
+                updateRange(chunkBegin, std::min(end, chunkBegin + parallelGrain));
+            });
+        } else {
+            updateRange(begin, end);
+        }
+    }
+
+    const auto result = static_cast<size_t>(std::count(dirty_.begin(), dirty_.end(), 1));
+    std::fill(dirty_.begin(), dirty_.end(), 0);
+    return result;
+}
+
+void TransformHierarchy::gatherWorld(glm::mat4 *destination, const Node *nodes, size_t count) const
+{
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = world_[slots_[nodes[i]]];
+    }
+}
+
+void TransformHierarchy::sort()
+{
+    // Depths from scratch, reparenting may have moved whole subtrees.
+    std::fill(depths_.begin(), depths_.end(), none);
+    std::vector<uint32_t> path;
+    for (uint32_t slot = 0; slot < nodes_.size(); slot++) {
+        auto s = slot;
+        while (depths_[s] == none && parents_[s] != none) {
+            path.push_back(s);
+            s = parents_[s];
+        }
+        if (depths_[s] == none) {
+            depths_[s] = 0;
+        }
+        for (auto depth = depths_[s] + 1; !path.empty(); depth++) {
+            depths_[path.back()] = depth;
+            path.pop_back();
+        }
+    }
+
+    // Counting sort, stable so that siblings keep their relative order.
+    const auto levelsCount = nodes_.empty() ? 0 : *std::max_element(depths_.begin(), depths_.end()) + 1;
+    levels_.assign(levelsCount + 1, 0);
+    for (const auto depth : depths_) {
+        levels_[depth + 1]++;
+    }
+    for (size_t level = 0; level < levelsCount; level++) {
+        levels_[level + 1] += levels_[level];
+    }
+
+    std::vector<uint32_t> order(nodes_.size());
+    auto cursors = levels_;
+    for (uint32_t slot = 0; slot < nodes_.size(); slot++) {
+        order[cursors[depths_[slot]]++] = slot;
+    }
+    permute(order);
+    unsorted_ = false;
+}
+
+void TransformHierarchy::permute(const std::vector<uint32_t> &order)
+{
+    // Surviving slots only, the parents of survivors survive too.
+    std::vector<uint32_t> newSlots(nodes_.size(), none);
+    for (uint32_t slot = 0; slot < order.size(); slot++) {
+        newSlots[order[slot]] = slot;
+    }
+    for (auto &parent : parents_) {
+        parent = parent == none ? none : newSlots[parent];
+    }
+
+    permuteArray(&parents_, order);
+    permuteArray(&depths_, order);
+    permuteArray(&positionX_, order);
+    permuteArray(&positionY_, order);
+    permuteArray(&positionZ_, order);
+    permuteArray(&rotationX_, order);
+    permuteArray(&rotationY_, order);
+    permuteArray(&rotationZ_, order);
+    permuteArray(&rotationW_, order);
+    permuteArray(&scaleX_, order);
+    permuteArray(&scaleY_, order);
+    permuteArray(&scaleZ_, order);
+    permuteArray(&world_, order);
+    permuteArray(&dirty_, order);
+    permuteArray(&nodes_, order);
+
+    for (uint32_t slot = 0; slot < nodes_.size(); slot++) {
+        slots_[nodes_[slot]] = slot;
+    }
+}
+
+void TransformHierarchy::updateRange(uint32_t begin, uint32_t end)
+{
+    // Local matrices of a block of nodes by element, element 3 * column + row of node
+    // block + j is local[3 * column + row][j]. The last block is padded, its last node
+    // repeated.
+    alignas(32) float padding[10][lanes];
+    alignas(32) float local[12][lanes];
+
+    for (auto block = begin; block < end; block += lanes) {
+        // The parent's level is done, its flag tells whether its world matrix changed.
+        const auto count = std::min(lanes, end - block);
+        uint8_t dirty = 0;
+        for (uint32_t j = 0; j < count; j++) {
+            const auto i = block + j;
+            if (parents_[i] != none) {
+                dirty_[i] |= dirty_[parents_[i]];
+            }
+            dirty |= dirty_[i];
+        }
+        if (!dirty) {
+            continue;
+        }
+
+        const auto load = [block, count](float (&lane)[lanes], const std::vector<float> &values) -> const float * {
+            if (count == lanes) {
+                return values.data() + block;
+            }
+            std::copy_n(values.data() + block, count, lane);
+            std::fill(lane + count, lane + lanes, values[block + count - 1]);
+            return lane;
+        };
+        const auto *px = load(padding[0], positionX_);
+        const auto *py = load(padding[1], positionY_);
+        const auto *pz = load(padding[2], positionZ_);
+        const auto *qx = load(padding[3], rotationX_);
+        const auto *qy = load(padding[4], rotationY_);
+        const auto *qz = load(padding[5], rotationZ_);
+        const auto *qw = load(padding[6], rotationW_);
+        const auto *sx = load(padding[7], scaleX_);
+        const auto *sy = load(padding[8], scaleY_);
+        const auto *sz = load(padding[9], scaleZ_);
+
+        // trs::toMatrix lane by lane.
+        for (uint32_t j = 0; j < lanes; j++) {
+            const auto xx = 2.0f * qx[j] * qx[j], yy = 2.0f * qy[j] * qy[j], zz = 2.0f * qz[j] * qz[j];
+            const auto xy = 2.0f * qx[j] * qy[j], xz = 2.0f * qx[j] * qz[j], yz = 2.0f * qy[j] * qz[j];
+            const auto wx = 2.0f * qw[j] * qx[j], wy = 2.0f * qw[j] * qy[j], wz = 2.0f * qw[j] * qz[j];
+            local[0][j] = (1.0f - yy - zz) * sx[j];
+            local[1][j] = (xy + wz) * sx[j];
+            local[2][j] = (xz - wy) * sx[j];
+            local[3][j] = (xy - wz) * sy[j];
+            local[4][j] = (1.0f - xx - zz) * sy[j];
+            local[5][j] = (yz + wx) * sy[j];
+            local[6][j] = (xz + wy) * sz[j];
+            local[7][j] = (yz - wx) * sz[j];
+            local[8][j] = (1.0f - xx - yy) * sz[j];
+            local[9][j] = px[j];
+            local[10][j] = py[j];
+            local[11][j] = pz[j];
+        }
+
+        // parent * local by columns, the last row of local is (0, 0, 0, 1). Gathering the
+        // parents into lanes costs more than it saves.
+        for (uint32_t j = 0; j < count; j++) {
+            const auto i = block + j;
+            if (!dirty_[i]) {
+                continue;
+            }
+            const auto &parent = parents_[i] == none ? identity : world_[parents_[i]];
+            auto &world = world_[i];
+            for (int column = 0; column < 4; column++) {
+                world[column] = parent[0] * local[3 * column][j] + parent[1] * local[3 * column + 1][j]
+                    + parent[2] * local[3 * column + 2][j];
+            }
+            world[3] += parent[3];
+        }
+    }
+}
+
+}
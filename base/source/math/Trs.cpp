@@ -0,0 +1,129 @@
+#include "gmt/math/Trs.h"
+
+#include <algorithm>
+
+#include "gmt/ThreadPool.h"
+
+namespace gmt
+{
+
+namespace
+{
+
+// Matrices per parallel task, and the size below which threads don't pay off.
+constexpr size_t parallelGrain = 8192;
+
+// Writes the rows of the affine matrices of [begin, end) to destination + i * stride, rows are
+// 4 floats apart when transposed and 1 apart otherwise. Branchless, the loop vectorizes.
+template <bool transposed>
+void writeMatrices(const TrsArray &trs, size_t begin, size_t end, float *destination, size_t stride)
+{
+    const auto *px = trs.positionX.data();
+    const auto *py = trs.positionY.data();
+    const auto *pz = trs.positionZ.data();
+    const auto *qx = trs.rotationX.data();
+    const auto *qy = trs.rotationY.data();
+    const auto *qz = trs.rotationZ.data();
+    const auto *qw = trs.rotationW.data();
+    const auto *sx = trs.scaleX.data();
+    const auto *sy = trs.scaleY.data();
+    const auto *sz = trs.scaleZ.data();
+
+    // Element (row, column) of matrix i.
+    const auto at = [destination, stride](size_t i, int row, int column) -> float & {
+        return destination[i * stride + (transposed ? row * 4 + column : column * 4 + row)];
+    };
+
+    for (auto i = begin; i < end; i++) {
+        const auto x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+        const auto xx = 2.0f * x * x, yy = 2.0f * y * y, zz = 2.0f * z * z;
+        const auto xy = 2.0f * x * y, xz = 2.0f * x * z, yz = 2.0f * y * z;
+        const auto wx = 2.0f * w * x, wy = 2.0f * w * y, wz = 2.0f * w * z;
+
+        at(i, 0, 0) = (1.0f - yy - zz) * sx[i];
+        at(i, 1, 0) = (xy + wz) * sx[i];
+        at(i, 2, 0) = (xz - wy) * sx[i];
+        at(i, 0, 1) = (xy - wz) * sy[i];
+        at(i, 1, 1) = (1.0f - xx - zz) * sy[i];
+        at(i, 2, 1) = (yz + wx) * sy[i];
+        at(i, 0, 2) = (xz + wy) * sz[i];
+        at(i, 1, 2) = (yz - wx) * sz[i];
+        at(i, 2, 2) = (1.0f - xx - yy) * sz[i];
+        at(i, 0, 3) = px[i];
+        at(i, 1, 3) = py[i];
+        at(i, 2, 3) = pz[i];
+        if constexpr (!transposed) {
+            at(i, 3, 0) = 0.0f;
+            at(i, 3, 1) = 0.0f;
+            at(i, 3, 2) = 0.0f;
+            at(i, 3, 3) = 1.0f;
+        }
+    }
+}
+
+template <bool transposed>
+void writeMatrices(const TrsArray &trs, float *destination, size_t stride, ThreadPool *pool)
+{
+    const auto count = trs.size();
+    if (!pool || count < 2 * parallelGrain) {
+        writeMatrices<transposed>(trs, 0, count, destination, stride);
+        return;
+    }
+
+    pool->parallelFor((count + parallelGrain - 1) / parallelGrain, 1, [&](size_t chunk) {
+        const auto begin = chunk * parallelGrain;
+        writeMatrices<transposed>(trs, begin, std::min(count, begin + parallelGrain), destination, stride);
+    });
+}
+
+}
+
+void TrsArray::resize(size_t size)
+{
+    // New elements are identities.
+    for (auto *v : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ }) {
+        v->resize(size);
+    }
+    for (auto *v : { &rotationW, &scaleX, &scaleY, &scaleZ }) {
+        v->resize(size, 1.0f);
+    }
+}
+
+void TrsArray::push_back(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    resize(size() + 1);
+    set(size() - 1, position, rotation, scale);
+}
+
+void TrsArray::set(size_t i, const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    positionX[i] = position.x;
+    positionY[i] = position.y;
+    positionZ[i] = position.z;
+    rotationX[i] = rotation.x;
+    rotationY[i] = rotation.y;
+    rotationZ[i] = rotation.z;
+    rotationW[i] = rotation.w;
+    scaleX[i] = scale.x;
+    scaleY[i] = scale.y;
+    scaleZ[i] = scale.z;
+}
+
+namespace trs
+{
+
+void toMatrices(const TrsArray &trs, glm::mat4 *destination, ThreadPool *pool)
+{
+    static_assert(sizeof(glm::mat4) == 16 * sizeof(float));
+    writeMatrices<false>(trs, reinterpret_cast<float*>(destination), 16, pool);
+}
+
+void toMatrices(const TrsArray &trs, glm::mat3x4 *destination, ThreadPool *pool)
+{
+    static_assert(sizeof(glm::mat3x4) == 12 * sizeof(float));
+    writeMatrices<true>(trs, reinterpret_cast<float*>(destination), 12, pool);
+}
+
+}
+
+}
@@ -0,0 +1,354 @@
+#include "gmt/mesh/Meshlets.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+namespace
+{
+
+constexpr uint32_t unused = std::numeric_limits<uint32_t>::max();
+
+// Below this the cone is wider than a half space less a margin, it would never cull.
+constexpr float minConeDot = 0.1f;
+
+MeshletBounds computeBounds(const MeshView &mesh, const uint32_t *vertices, size_t verticesCount,
+    const uint8_t *triangles, size_t trianglesCount)
+{
+    std::vector<glm::vec3> positions(verticesCount);
+    for (size_t i = 0; i < verticesCount; i++) {
+        positions[i] = mesh.position(vertices[i]);
+    }
+
+    MeshletBounds result;
+    result.sphere = Sphere::fromPoints(positions.data(), positions.size());
+    result.coneApex = result.sphere.center;
+    result.coneAxis = glm::vec3{ 0.0f };
+    result.coneCutoff = 1.0f;
+
+    std::vector<glm::vec3> normals;
+    glm::vec3 axis{ 0.0f };
+    for (size_t t = 0; t < trianglesCount; t++) {
+        const auto &a = positions[triangles[t * 3]];
+        const auto &b = positions[triangles[t * 3 + 1]];
+        const auto &c = positions[triangles[t * 3 + 2]];
+        const auto n = glm::cross(b - a, c - a);
+        const auto length = glm::length(n);
+        if (length > 0.0f) {
+            normals.push_back(n / length);
+            axis += normals.back();
+        }
+    }
+
+    const auto axisLength = glm::length(axis);
+    if (axisLength == 0.0f) {
+        return result;
+    }
+    axis /= axisLength;
+
+    auto minDot = 1.0f;
+    for (const auto &n : normals) {
+        minDot = std::min(minDot, glm::dot(axis, n));
+    }
+    if (minDot <= minConeDot) {
+        return result;
+    }
+
+    // Move the apex back along the axis until it is behind every triangle plane, then any eye in
+    // the cone sees every triangle from behind.
+    auto maxT = 0.0f;
+    for (size_t t = 0, i = 0; t < trianglesCount; t++) {
+        const auto &a = positions[triangles[t * 3]];
+        const auto &b = positions[triangles[t * 3 + 1]];
+        const auto &c = positions[triangles[t * 3 + 2]];
+        if (glm::length(glm::cross(b - a, c - a)) == 0.0f) {
+            continue;
+        }
+        const auto &n = normals[i++];
+        maxT = std::max(maxT, glm::dot(result.sphere.center - a, n) / glm::dot(axis, n));
+    }
+
+    result.coneApex = result.sphere.center - axis * maxT;
+    result.coneAxis = axis;
+    result.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    return result;
+}
+
+bool occluded(const Sphere &sphere, const glm::mat4 &viewProj, const DepthPyramid &pyramid)
+{
+    const auto box = sphere.bounds();
+    glm::vec2 min{ std::numeric_limits<float>::max() };
+    glm::vec2 max{ -std::numeric_limits<float>::max() };
+    auto nearest = pyramid.isReversed() ? 0.0f : 1.0f;
+    for (int i = 0; i < 8; i++) {
+        const glm::vec3 corner{ i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y,
+            i & 4 ? box.max.z : box.min.z };
+        const auto clip = viewProj * glm::vec4{ corner, 1.0f };
+
+        // Crosses the near plane, the projection is unbounded.
+        if (clip.w <= std::numeric_limits<float>::epsilon()) {
+            return false;
+        }
+
+        const auto ndc = glm::vec3{ clip } / clip.w;
+        min = glm::min(min, glm::vec2{ ndc });
+        max = glm::max(max, glm::vec2{ ndc });
+
+        // Standard projections map -1 to 1 to window depths, reversed ones 0 to 1 directly.
+        nearest = pyramid.isReversed() ? std::max(nearest, ndc.z) : std::min(nearest, ndc.z * 0.5f + 0.5f);
+    }
+
+    min = glm::clamp(min * 0.5f + 0.5f, 0.0f, 1.0f);
+    max = glm::clamp(max * 0.5f + 0.5f, 0.0f, 1.0f);
+    return !pyramid.visible(min, max, nearest);
+}
+
+}
+
+Meshlets buildMeshlets(const MeshView &mesh, size_t maxVertices, size_t maxTriangles)
+{
+    assert(maxVertices >= 3 && maxVertices <= 256 && maxTriangles > 0);
+
+    const auto trianglesCount = mesh.trianglesCount();
+    const auto verticesCount = mesh.verticesCount();
+
+    // Triangles around every vertex.
+    std::vector<uint32_t> offsets(verticesCount + 1, 0);
+    for (size_t i = 0; i < trianglesCount * 3; i++) {
+        offsets[mesh.index(i) + 1]++;
+    }
+    for (size_t v = 0; v < verticesCount; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<uint32_t> adjacency(trianglesCount * 3);
+    {
+        auto cursors = offsets;
+        for (size_t i = 0; i < trianglesCount * 3; i++) {
+            adjacency[cursors[mesh.index(i)]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    Meshlets result;
+    std::vector<uint8_t> emitted(trianglesCount, 0);
+    std::vector<uint32_t> slots(verticesCount, unused);
+    std::vector<uint32_t> vertices;
+    std::vector<uint8_t> triangles;
+    glm::vec3 centroid{ 0.0f };
+
+    const auto newVertices = [&](size_t t) {
+        uint32_t count = 0;
+        for (int k = 0; k < 3; k++) {
+            const auto v = mesh.index(t * 3 + k);
+            count += slots[v] == unused ? 1 : 0;
+        }
+        // Repeated vertices of degenerate triangles count once.
+        const auto a = mesh.index(t * 3);
+        const auto b = mesh.index(t * 3 + 1);
+        const auto c = mesh.index(t * 3 + 2);
+        if (slots[a] == unused && (a == b || a == c)) {
+            count--;
+        }
+        if (slots[b] == unused && b == c) {
+            count--;
+        }
+        return count;
+    };
+
+    const auto add = [&](size_t t) {
+        for (int k = 0; k < 3; k++) {
+            const auto v = mesh.index(t * 3 + k);
+            if (slots[v] == unused) {
+                slots[v] = static_cast<uint32_t>(vertices.size());
+                vertices.push_back(v);
+                centroid += mesh.position(v);
+            }
+            triangles.push_back(static_cast<uint8_t>(slots[v]));
+        }
+        emitted[t] = 1;
+    };
+
+    const auto flush = [&]() {
+        Meshlet meshlet;
+        meshlet.verticesOffset = static_cast<uint32_t>(result.vertices.size());
+        meshlet.verticesCount = static_cast<uint32_t>(vertices.size());
+        meshlet.trianglesOffset = static_cast<uint32_t>(result.triangles.size() / 3);
+        meshlet.trianglesCount = static_cast<uint32_t>(triangles.size() / 3);
+        result.meshlets.push_back(meshlet);
+        result.bounds.push_back(
+            computeBounds(mesh, vertices.data(), vertices.size(), triangles.data(), triangles.size() / 3));
+
+        result.vertices.insert(result.vertices.end(), vertices.begin(), vertices.end());
+        result.triangles.insert(result.triangles.end(), triangles.begin(), triangles.end());
+        for (const auto v : vertices) {
+            slots[v] = unused;
+        }
+        vertices.clear();
+        triangles.clear();
+        centroid = glm::vec3{ 0.0f };
+    };
+
+    size_t seed = 0;
+    while (true) {
+        // The adjacent triangle adding the fewest vertices, ties go to the one nearest the center
+        // so that meshlets grow round rather than in strips.
+        auto best = unused;
+        auto bestCost = unused;
+        auto bestDistance = std::numeric_limits<float>::max();
+        if (triangles.size() / 3 < maxTriangles) {
+            const auto center = centroid / static_cast<float>(vertices.size());
+            for (const auto v : vertices) {
+                for (auto i = offsets[v]; i < offsets[v + 1]; i++) {
+                    const auto t = adjacency[i];
+                    if (emitted[t] || t == best) {
+                        continue;
+                    }
+                    const auto cost = newVertices(t);
+                    if (vertices.size() + cost > maxVertices || cost > bestCost) {
+                        continue;
+                    }
+                    const auto d = mesh.position(mesh.index(t * 3)) + mesh.position(mesh.index(t * 3 + 1))
+                        + mesh.position(mesh.index(t * 3 + 2)) - center * 3.0f;
+                    const auto distance = glm::dot(d, d);
+                    if (cost < bestCost || distance < bestDistance) {
+                        best = t;
+                        bestCost = cost;
+                        bestDistance = distance;
+                    }
+                }
+            }
+        }
+
+        if (best != unused) {
+            add(best);
+            continue;
+        }
+        if (!vertices.empty()) {
+            flush();
+            continue;
+        }
+
+        while (seed < trianglesCount && emitted[seed]) {
+            seed++;
+        }
+        if (seed == trianglesCount) {
+            break;
+        }
+        add(seed);
+    }
+    return result;
+}
+
+DepthPyramid::DepthPyramid(const float *depth, uint32_t width, uint32_t height, bool reversed)
+    : reversed_{ reversed }
+{
+    assert(width > 0 && height > 0);
+    levels_.push_back(Level{ width, height, std::vector<float>(depth, depth + width * height) });
+
+    const auto farthest = [reversed](float a, float b) { return reversed ? std::min(a, b) : std::max(a, b); };
+    while (levels_.back().width > 1 || levels_.back().height > 1) {
+        const auto &source = levels_.back();
+        Level level{ (source.width + 1) / 2, (source.height + 1) / 2, {} };
+        level.depth.resize(level.width * level.height);
+
+        // Odd sizes clamp, the last texel of a row or column covers the remaining source texel.
+        for (uint32_t y = 0; y < level.height; y++) {
+            const auto y0 = 2 * y;
+            const auto y1 = std::min(2 * y + 1, source.height - 1);
+            for (uint32_t x = 0; x < level.width; x++) {
+                const auto x0 = 2 * x;
+                const auto x1 = std::min(2 * x + 1, source.width - 1);
+                level.depth[y * level.width + x] = farthest(
+                    farthest(source.depth[y0 * source.width + x0], source.depth[y0 * source.width + x1]),
+                    farthest(source.depth[y1 * source.width + x0], source.depth[y1 * source.width + x1]));
+            }
+        }
+        levels_.push_back(std::move(level));
+    }
+}
+
+float DepthPyramid::getDepth(size_t level, uint32_t x, uint32_t y) const
+{
+    const auto &l = levels_[level];
+    return l.depth[y * l.width + x];
+}
+
+bool DepthPyramid::visible(const glm::vec2 &min, const glm::vec2 &max, float nearest) const
+{
+    if (levels_.empty()) {
+        return true;
+    }
+
+    // The level where the rectangle spans at most two texels each way.
+    const auto size = (max - min) * glm::vec2{ levels_[0].width, levels_[0].height };
+    const auto extent = std::max(size.x, size.y);
+    const auto level = extent > 1.0f
+        ? std::min(static_cast<size_t>(std::ceil(std::log2(extent))), levels_.size() - 1)
+        : size_t{ 0 };
+
+    // Texels of level 0 shifted down, a level texel covers two of the one below also when
+    // the sizes are odd, so scaling by the level size would miss source texels.
+    const auto &l = levels_[level];
+    const auto texel = [level](float t, uint32_t size) {
+        return std::min(static_cast<uint32_t>(std::max(t * size, 0.0f)), size - 1) >> level;
+    };
+    const auto x0 = texel(min.x, levels_[0].width);
+    const auto x1 = texel(max.x, levels_[0].width);
+    const auto y0 = texel(min.y, levels_[0].height);
+    const auto y1 = texel(max.y, levels_[0].height);
+
+    auto farthest = reversed_ ? 1.0f : 0.0f;
+    for (auto y = y0; y <= y1; y++) {
+        for (auto x = x0; x <= x1; x++) {
+            const auto d = l.depth[y * l.width + x];
+            farthest = reversed_ ? std::min(farthest, d) : std::max(farthest, d);
+        }
+    }
+    return reversed_ ? nearest >= farthest : nearest <= farthest;
+}
+
+namespace details
+{
+
+void cullMeshlets(const Meshlets &meshlets, const glm::mat4 &model, const ClusterCullView &view,
+    std::vector<uint32_t> *visible)
+{
+    // Cones are tested in mesh space, back facing is preserved by affine transforms.
+    const auto eye = glm::inverse(model) * view.eye;
+
+    for (uint32_t m = 0; m < meshlets.size(); m++) {
+        const auto &bounds = meshlets.bounds[m];
+
+        if (bounds.coneCutoff < 1.0f) {
+            const auto direction = bounds.coneApex * eye.w - glm::vec3{ eye };
+            const auto length = glm::length(direction);
+            if (length > 0.0f && glm::dot(direction, bounds.coneAxis) >= bounds.coneCutoff * length) {
+                continue;
+            }
+        }
+
+        const auto sphere = bounds.sphere.transformed(model);
+        if (std::any_of(std::begin(view.planes), std::end(view.planes),
+                [&sphere](const auto &p) { return p && sphere.outside(p); })) {
+            continue;
+        }
+
+        if (view.depthPyramid && !view.depthPyramid->empty() && occluded(sphere, view.viewProj, *view.depthPyramid)) {
+            continue;
+        }
+
+        visible->push_back(m);
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,376 @@
+#include "gmt/mesh/Optimize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+namespace
+{
+
+constexpr uint32_t unused = std::numeric_limits<uint32_t>::max();
+
+// FIFO cache, a vertex is cached if fewer than size vertices were transformed since its own transform.
+class CacheSimulator
+{
+public:
+    CacheSimulator(size_t verticesCount, unsigned size)
+        : stamps_(verticesCount, 0)
+        , size_{ size }
+        , time_{ size + 1 }
+    {
+    }
+
+    // Returns 1 on a miss.
+    uint32_t access(uint32_t vertex)
+    {
+        if (time_ - stamps_[vertex] > size_) {
+            stamps_[vertex] = time_++;
+            return 1;
+        }
+        return 0;
+    }
+
+    void reset() { time_ += size_ + 1; }
+
+private:
+    std::vector<uint32_t> stamps_;
+    uint32_t size_;
+    uint32_t time_;
+};
+
+struct Cluster
+{
+    size_t begin;
+    size_t end;
+    float sortKey;
+};
+
+OverdrawStatistics rasterize(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices)
+{
+    constexpr int gridSize = 256;
+
+    glm::vec3 min{ std::numeric_limits<float>::max() };
+    glm::vec3 max{ -std::numeric_limits<float>::max() };
+    for (const auto index : indices) {
+        min = glm::min(min, positions[index]);
+        max = glm::max(max, positions[index]);
+    }
+    const auto extent = std::max({ max.x - min.x, max.y - min.y, max.z - min.z });
+    const auto scale = extent > 0.0f ? (gridSize - 1) / extent : 0.0f;
+
+    OverdrawStatistics result{ 0, 0, 0.0f };
+    std::vector<float> depth(gridSize * gridSize);
+
+    for (int axis = 0; axis < 3; axis++) {
+        const auto u = (axis + 1) % 3;
+        const auto v = (axis + 2) % 3;
+
+        for (const auto direction : { 1.0f, -1.0f }) {
+            std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::max());
+
+            // Looking down -axis for direction 1, x is mirrored for the opposite view to keep the winding.
+            const auto project = [&](uint32_t index) {
+                const auto p = (positions[index] - min) * scale;
+                const auto x = direction > 0.0f ? p[u] : gridSize - 1 - p[u];
+                return glm::vec3(x, p[v], -direction * p[axis]);
+            };
+
+            for (size_t t = 0; t < indices.size(); t += 3) {
+                const auto p0 = project(indices[t + 0]);
+                const auto p1 = project(indices[t + 1]);
+                const auto p2 = project(indices[t + 2]);
+
+                const auto area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+                if (area <= 0.0f) {
+                    continue;
+                }
+
+                const auto minX = std::max(0, static_cast<int>(std::floor(std::min({ p0.x, p1.x, p2.x }))));
+                const auto maxX = std::min(gridSize - 1, static_cast<int>(std::ceil(std::max({ p0.x, p1.x, p2.x }))));
+                const auto minY = std::max(0, static_cast<int>(std::floor(std::min({ p0.y, p1.y, p2.y }))));
+                const auto maxY = std::min(gridSize - 1, static_cast<int>(std::ceil(std::max({ p0.y, p1.y, p2.y }))));
+
+                for (int y = minY; y <= maxY; y++) {
+                    for (int x = minX; x <= maxX; x++) {
+                        const auto px = x + 0.5f;
+                        const auto py = y + 0.5f;
+                        const auto w0 = (p2.x - p1.x) * (py - p1.y) - (p2.y - p1.y) * (px - p1.x);
+                        const auto w1 = (p0.x - p2.x) * (py - p2.y) - (p0.y - p2.y) * (px - p2.x);
+                        const auto w2 = (p1.x - p0.x) * (py - p0.y) - (p1.y - p0.y) * (px - p0.x);
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                            continue;
+                        }
+
+                        const auto z = (w0 * p0.z + w1 * p1.z + w2 * p2.z) / area;
+                        auto &d = depth[y * gridSize + x];
+                        if (z < d) {
+                            d = z;
+                            result.pixelsShaded++;
+                        }
+                    }
+                }
+            }
+
+            result.pixelsCovered += static_cast<uint32_t>(std::count_if(depth.begin(), depth.end(),
+                [](float d) { return d != std::numeric_limits<float>::max(); }));
+        }
+    }
+
+    result.overdraw = result.pixelsCovered > 0
+        ? static_cast<float>(result.pixelsShaded) / result.pixelsCovered
+        : 0.0f;
+    return result;
+}
+
+}
+
+OverdrawStatistics analyzeOverdraw(const MeshView &mesh)
+{
+    std::vector<glm::vec3> positions(mesh.verticesCount());
+    for (uint32_t v = 0; v < positions.size(); v++) {
+        positions[v] = mesh.position(v);
+    }
+
+    std::vector<uint32_t> indices(mesh.trianglesCount() * 3);
+    for (size_t i = 0; i < indices.size(); i++) {
+        indices[i] = mesh.index(i);
+    }
+
+    return rasterize(positions, indices);
+}
+
+namespace details
+{
+
+VertexCacheStatistics analyzeVertexCache(const std::vector<uint32_t> &indices, size_t verticesCount,
+    unsigned cacheSize)
+{
+    CacheSimulator cache{ verticesCount, cacheSize };
+    std::vector<uint8_t> referenced(verticesCount, 0);
+
+    uint32_t transformed = 0;
+    for (const auto index : indices) {
+        transformed += cache.access(index);
+        referenced[index] = 1;
+    }
+
+    const auto trianglesCount = indices.size() / 3;
+    const auto referencedCount = std::count(referenced.begin(), referenced.end(), uint8_t{ 1 });
+    return VertexCacheStatistics{
+        transformed,
+        trianglesCount > 0 ? static_cast<float>(transformed) / trianglesCount : 0.0f,
+        referencedCount > 0 ? static_cast<float>(transformed) / referencedCount : 0.0f
+    };
+}
+
+std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t> &indices, size_t verticesCount,
+    unsigned cacheSize)
+{
+    // Tipsify, Sander et al. 2007: fans around a vertex at a time, the next fanning vertex is the
+    // one that will still be in the cache after its remaining triangles are emitted.
+    const auto trianglesCount = indices.size() / 3;
+
+    std::vector<uint32_t> live(verticesCount, 0);
+    for (size_t i = 0; i < trianglesCount * 3; i++) {
+        live[indices[i]]++;
+    }
+
+    std::vector<uint32_t> offsets(verticesCount + 1, 0);
+    for (size_t v = 0; v < verticesCount; v++) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+
+    std::vector<uint32_t> adjacency(trianglesCount * 3);
+    {
+        auto cursors = offsets;
+        for (size_t i = 0; i < trianglesCount * 3; i++) {
+            adjacency[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(verticesCount, 0);
+    std::vector<uint8_t> emitted(trianglesCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    deadEnd.reserve(trianglesCount * 3);
+    result.reserve(trianglesCount * 3);
+
+    uint32_t time = cacheSize + 1;
+    uint32_t cursor = 0;
+
+    const auto skipDeadEnd = [&]() {
+        while (!deadEnd.empty()) {
+            const auto v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v] > 0) {
+                return static_cast<int64_t>(v);
+            }
+        }
+        for (; cursor < verticesCount; cursor++) {
+            if (live[cursor] > 0) {
+                return static_cast<int64_t>(cursor);
+            }
+        }
+        return int64_t{ -1 };
+    };
+
+    auto fanning = skipDeadEnd();
+    while (fanning >= 0) {
+        candidates.clear();
+        for (auto k = offsets[fanning]; k < offsets[fanning + 1]; k++) {
+            const auto t = adjacency[k];
+            if (emitted[t]) {
+                continue;
+            }
+            emitted[t] = 1;
+
+            for (int j = 0; j < 3; j++) {
+                const auto v = indices[t * 3 + j];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                if (time - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = time++;
+                }
+            }
+        }
+
+        int64_t best = -1;
+        int64_t bestPriority = -1;
+        for (const auto v : candidates) {
+            if (live[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * live[v] <= cacheSize) {
+                priority = time - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+
+        fanning = best >= 0 ? best : skipDeadEnd();
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> optimizeOverdraw(const MeshView &mesh, float threshold, unsigned cacheSize)
+{
+    const auto trianglesCount = mesh.trianglesCount();
+    std::vector<uint32_t> indices(trianglesCount * 3);
+    for (size_t i = 0; i < indices.size(); i++) {
+        indices[i] = mesh.index(i);
+    }
+
+    CacheSimulator cache{ mesh.verticesCount(), cacheSize };
+    const auto misses = [&](size_t t) {
+        return cache.access(indices[t * 3]) + cache.access(indices[t * 3 + 1]) + cache.access(indices[t * 3 + 2]);
+    };
+
+    // Hard boundaries where the cache starts over, a triangle with no cached vertex.
+    std::vector<size_t> hard;
+    for (size_t t = 0; t < trianglesCount; t++) {
+        if (misses(t) == 3) {
+            hard.push_back(t);
+        }
+    }
+    hard.push_back(trianglesCount);
+
+    // Soft boundaries split hard clusters as soon as the ACMR so far is within threshold of the
+    // whole cluster's, the cache restarts at every cut.
+    std::vector<Cluster> clusters;
+    for (size_t h = 0; h + 1 < hard.size(); h++) {
+        const auto begin = hard[h];
+        const auto end = hard[h + 1];
+
+        cache.reset();
+        uint32_t clusterMisses = 0;
+        for (auto t = begin; t < end; t++) {
+            clusterMisses += misses(t);
+        }
+        const auto targetAcmr = static_cast<float>(clusterMisses) / (end - begin) * threshold;
+
+        cache.reset();
+        auto start = begin;
+        uint32_t running = 0;
+        for (auto t = begin; t < end; t++) {
+            running += misses(t);
+            if (t + 1 < end && running <= targetAcmr * (t - start + 1)) {
+                clusters.push_back(Cluster{ start, t + 1, 0.0f });
+                start = t + 1;
+                running = 0;
+                cache.reset();
+            }
+        }
+        clusters.push_back(Cluster{ start, end, 0.0f });
+    }
+
+    // Clusters facing away from the mesh center are likely to occlude the others, draw them first.
+    glm::vec3 meshCentroid{ 0.0f };
+    float meshArea = 0.0f;
+    std::vector<glm::vec3> centroids(clusters.size(), glm::vec3{ 0.0f });
+    std::vector<glm::vec3> normals(clusters.size(), glm::vec3{ 0.0f });
+    for (size_t c = 0; c < clusters.size(); c++) {
+        float clusterArea = 0.0f;
+        for (auto t = clusters[c].begin; t < clusters[c].end; t++) {
+            const auto p0 = mesh.position(indices[t * 3]);
+            const auto p1 = mesh.position(indices[t * 3 + 1]);
+            const auto p2 = mesh.position(indices[t * 3 + 2]);
+            const auto normal = glm::cross(p1 - p0, p2 - p0);
+            const auto area = glm::length(normal);
+            centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[c] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += clusterArea;
+        centroids[c] = clusterArea > 0.0f ? centroids[c] / clusterArea : centroids[c];
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+    for (size_t c = 0; c < clusters.size(); c++) {
+        const auto length = glm::length(normals[c]);
+        clusters[c].sortKey = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+        [](const Cluster &a, const Cluster &b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (const auto &cluster : clusters) {
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+    return result;
+}
+
+std::vector<uint32_t> firstUseRemap(const std::vector<uint32_t> &indices, size_t verticesCount, size_t *count)
+{
+    std::vector<uint32_t> remap(verticesCount, unused);
+    uint32_t next = 0;
+    for (const auto index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = next++;
+        }
+    }
+    *count = next;
+    return remap;
+}
+
+}
+
+}
+
+}
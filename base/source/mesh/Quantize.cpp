@@ -0,0 +1,101 @@
+#include "gmt/mesh/Quantize.h"
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+namespace
+{
+
+// Rounds half away from zero like std::lround, without the call that keeps loops scalar.
+float roundAway(float value)
+{
+    return value + (value >= 0.0f ? 0.5f : -0.5f);
+}
+
+}
+
+void quantizeHalf(uint16_t *destination, const float *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = quantizeHalf(values[i]);
+    }
+}
+
+void quantizeSnorm8(int8_t *destination, const float *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = static_cast<int8_t>(roundAway(std::clamp(values[i], -1.0f, 1.0f) * 127.0f));
+    }
+}
+
+void quantizeUnorm8(uint8_t *destination, const float *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = static_cast<uint8_t>(std::clamp(values[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+void quantizeSnorm16(int16_t *destination, const float *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = static_cast<int16_t>(roundAway(std::clamp(values[i], -1.0f, 1.0f) * 32767.0f));
+    }
+}
+
+void quantizeUnorm16(uint16_t *destination, const float *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        destination[i] = static_cast<uint16_t>(std::clamp(values[i], 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+}
+
+void packSnorm1010102(uint32_t *destination, const glm::vec4 *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const auto &v = values[i];
+        const auto x = static_cast<int32_t>(roundAway(std::clamp(v.x, -1.0f, 1.0f) * 511.0f));
+        const auto y = static_cast<int32_t>(roundAway(std::clamp(v.y, -1.0f, 1.0f) * 511.0f));
+        const auto z = static_cast<int32_t>(roundAway(std::clamp(v.z, -1.0f, 1.0f) * 511.0f));
+        const auto w = static_cast<int32_t>(roundAway(std::clamp(v.w, -1.0f, 1.0f)));
+        destination[i] = (static_cast<uint32_t>(x) & 0x3ffu)
+            | (static_cast<uint32_t>(y) & 0x3ffu) << 10
+            | (static_cast<uint32_t>(z) & 0x3ffu) << 20
+            | (static_cast<uint32_t>(w) & 0x3u) << 30;
+    }
+}
+
+void packUnorm1010102(uint32_t *destination, const glm::vec4 *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const auto &v = values[i];
+        destination[i] = static_cast<uint32_t>(std::clamp(v.x, 0.0f, 1.0f) * 1023.0f + 0.5f)
+            | static_cast<uint32_t>(std::clamp(v.y, 0.0f, 1.0f) * 1023.0f + 0.5f) << 10
+            | static_cast<uint32_t>(std::clamp(v.z, 0.0f, 1.0f) * 1023.0f + 0.5f) << 20
+            | static_cast<uint32_t>(std::clamp(v.w, 0.0f, 1.0f) * 3.0f + 0.5f) << 30;
+    }
+}
+
+void encodeOctahedral(int16_t *destination, const glm::vec3 *normals, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const auto &normal = normals[i];
+        const auto invLength = 1.0f / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+        const auto x = normal.x * invLength;
+        const auto y = normal.y * invLength;
+
+        // The lower hemisphere folds over the diagonals, both results are computed and selected.
+        const auto foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const auto foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        const auto lower = normal.z < 0.0f;
+
+        destination[i * 2] = static_cast<int16_t>(roundAway(std::clamp(lower ? foldedX : x, -1.0f, 1.0f) * 32767.0f));
+        destination[i * 2 + 1] = static_cast<int16_t>(roundAway(std::clamp(lower ? foldedY : y, -1.0f, 1.0f) * 32767.0f));
+    }
+}
+
+}
+
+}
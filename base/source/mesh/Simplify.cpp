@@ -0,0 +1,501 @@
+#include "gmt/mesh/Simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "gmt/ThreadPool.h"
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+namespace
+{
+
+// Border planes are weighted up so that borders keep their shape.
+constexpr float borderWeight = 10.0f;
+
+enum class Kind : uint8_t
+{
+    Manifold,
+    Border,
+    Seam,
+    Locked,
+};
+
+// Sum of squared distances to a set of weighted planes, stored as the upper half of a 4x4 matrix.
+struct Quadric
+{
+    void addPlane(const glm::vec3 &n, float d, float weight)
+    {
+        a2 += weight * n.x * n.x;
+        b2 += weight * n.y * n.y;
+        c2 += weight * n.z * n.z;
+        ab += weight * n.x * n.y;
+        ac += weight * n.x * n.z;
+        bc += weight * n.y * n.z;
+        ad += weight * n.x * d;
+        bd += weight * n.y * d;
+        cd += weight * n.z * d;
+        d2 += weight * d * d;
+        w += weight;
+    }
+
+    void add(const Quadric &q)
+    {
+        a2 += q.a2;
+        b2 += q.b2;
+        c2 += q.c2;
+        ab += q.ab;
+        ac += q.ac;
+        bc += q.bc;
+        ad += q.ad;
+        bd += q.bd;
+        cd += q.cd;
+        d2 += q.d2;
+        w += q.w;
+    }
+
+    // Weighted mean of squared distances.
+    float evaluate(const glm::vec3 &p) const
+    {
+        const auto r = a2 * p.x * p.x + b2 * p.y * p.y + c2 * p.z * p.z
+            + 2.0f * (ab * p.x * p.y + ac * p.x * p.z + bc * p.y * p.z)
+            + 2.0f * (ad * p.x + bd * p.y + cd * p.z) + d2;
+        return w > 0.0f ? std::abs(r) / w : 0.0f;
+    }
+
+    float a2{ 0.0f }, b2{ 0.0f }, c2{ 0.0f };
+    float ab{ 0.0f }, ac{ 0.0f }, bc{ 0.0f };
+    float ad{ 0.0f }, bd{ 0.0f }, cd{ 0.0f };
+    float d2{ 0.0f };
+    float w{ 0.0f };
+};
+
+struct Collapse
+{
+    uint32_t from;
+    uint32_t to;
+    float error;
+};
+
+uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+struct PositionHash
+{
+    size_t operator()(const glm::vec3 &p) const
+    {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+class Simplifier
+{
+public:
+    Simplifier(const MeshView &mesh)
+        : positions_(mesh.verticesCount())
+        , canonical_(mesh.verticesCount())
+        , wedge_(mesh.verticesCount())
+        , kinds_(mesh.verticesCount())
+        , quadrics_(mesh.verticesCount())
+        , indices_(mesh.trianglesCount() * 3)
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> unique;
+        for (uint32_t v = 0; v < positions_.size(); v++) {
+            positions_[v] = mesh.position(v);
+            const auto it = unique.emplace(positions_[v], v).first;
+            const auto c = it->second;
+            canonical_[v] = c;
+            wedge_[v] = v;
+            if (c != v) {
+                wedge_[v] = wedge_[c];
+                wedge_[c] = v;
+            }
+        }
+
+        for (size_t i = 0; i < indices_.size(); i++) {
+            indices_[i] = mesh.index(i);
+        }
+    }
+
+    std::vector<uint32_t> run(size_t targetIndicesCount, float maxError, float *error)
+    {
+        const auto maxError2 = maxError < std::sqrt(std::numeric_limits<float>::max())
+            ? maxError * maxError
+            : std::numeric_limits<float>::max();
+        const auto targetTriangles = targetIndicesCount / 3;
+
+        removeDegenerates();
+        classify();
+        computeQuadrics();
+
+        float resultError2 = 0.0f;
+        while (indices_.size() / 3 > targetTriangles) {
+            classify();
+            const auto collapsed = pass(indices_.size() / 3 - targetTriangles, maxError2, &resultError2);
+            if (!collapsed) {
+                break;
+            }
+            removeDegenerates();
+        }
+
+        if (error) {
+            *error = std::sqrt(resultError2);
+        }
+        return std::move(indices_);
+    }
+
+private:
+    std::vector<glm::vec3> positions_;
+    std::vector<uint32_t> canonical_;
+    std::vector<uint32_t> wedge_; // Ring of the vertices sharing a position.
+    std::vector<Kind> kinds_;     // By canonical vertex.
+    std::vector<Quadric> quadrics_; // By canonical vertex.
+    std::vector<uint32_t> indices_;
+
+    std::unordered_set<uint64_t> edges_;
+    std::unordered_set<uint64_t> positionEdges_;
+
+    bool hasEdge(uint32_t a, uint32_t b) const { return edges_.count(edgeKey(a, b)) != 0; }
+
+    bool hasPositionEdge(uint32_t a, uint32_t b) const
+    {
+        return positionEdges_.count(edgeKey(canonical_[a], canonical_[b])) != 0;
+    }
+
+    glm::vec3 normal(uint32_t a, uint32_t b, uint32_t c) const
+    {
+        return glm::cross(positions_[b] - positions_[a], positions_[c] - positions_[a]);
+    }
+
+    void removeDegenerates()
+    {
+        size_t write = 0;
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            const auto a = canonical_[indices_[t]];
+            const auto b = canonical_[indices_[t + 1]];
+            const auto c = canonical_[indices_[t + 2]];
+            if (a != b && b != c && c != a) {
+                std::copy(indices_.begin() + t, indices_.begin() + t + 3, indices_.begin() + write);
+                write += 3;
+            }
+        }
+        indices_.resize(write);
+    }
+
+    void classify()
+    {
+        edges_.clear();
+        positionEdges_.clear();
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                const auto a = indices_[t + k];
+                const auto b = indices_[t + (k + 1) % 3];
+                edges_.insert(edgeKey(a, b));
+                positionEdges_.insert(edgeKey(canonical_[a], canonical_[b]));
+            }
+        }
+
+        // Open edges: no opposite half edge between the same vertices. Border edges: not even
+        // between the same positions. Open edges that aren't border edges are seams.
+        std::vector<uint8_t> openOut(positions_.size(), 0);
+        std::vector<uint8_t> openIn(positions_.size(), 0);
+        std::vector<uint8_t> borderOut(positions_.size(), 0);
+        std::vector<uint8_t> borderIn(positions_.size(), 0);
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                const auto a = indices_[t + k];
+                const auto b = indices_[t + (k + 1) % 3];
+                if (!hasEdge(b, a)) {
+                    openOut[a] = static_cast<uint8_t>(std::min(openOut[a] + 1, 255));
+                    openIn[b] = static_cast<uint8_t>(std::min(openIn[b] + 1, 255));
+                }
+                if (!hasPositionEdge(b, a)) {
+                    borderOut[a] = static_cast<uint8_t>(std::min(borderOut[a] + 1, 255));
+                    borderIn[b] = static_cast<uint8_t>(std::min(borderIn[b] + 1, 255));
+                }
+            }
+        }
+
+        for (uint32_t v = 0; v < positions_.size(); v++) {
+            if (canonical_[v] != v) {
+                continue;
+            }
+
+            const auto w = wedge_[v];
+            const auto wedges = w == v ? 1 : (wedge_[w] == v ? 2 : 3);
+            auto kind = Kind::Locked;
+            if (wedges == 1) {
+                if (openOut[v] == 0 && openIn[v] == 0) {
+                    kind = Kind::Manifold;
+                } else if (openOut[v] == 1 && openIn[v] == 1 && borderOut[v] == 1 && borderIn[v] == 1) {
+                    kind = Kind::Border;
+                }
+            } else if (wedges == 2) {
+                const auto seam = [&](uint32_t x) {
+                    return openOut[x] == 1 && openIn[x] == 1 && borderOut[x] == 0 && borderIn[x] == 0;
+                };
+                if (seam(v) && seam(w)) {
+                    kind = Kind::Seam;
+                }
+            }
+            kinds_[v] = kind;
+        }
+    }
+
+    void computeQuadrics()
+    {
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            const auto a = indices_[t];
+            const auto b = indices_[t + 1];
+            const auto c = indices_[t + 2];
+            const auto n = normal(a, b, c);
+            const auto length = glm::length(n);
+            if (length == 0.0f) {
+                continue;
+            }
+
+            const auto unit = n / length;
+            const auto d = -glm::dot(unit, positions_[a]);
+            const auto area = length * 0.5f;
+            for (const auto v : { a, b, c }) {
+                quadrics_[canonical_[v]].addPlane(unit, d, area);
+            }
+
+            // Planes through border edges, perpendicular to the triangle.
+            const uint32_t corners[] = { a, b, c };
+            for (int k = 0; k < 3; k++) {
+                const auto p = corners[k];
+                const auto q = corners[(k + 1) % 3];
+                if (hasPositionEdge(q, p)) {
+                    continue;
+                }
+                const auto edge = positions_[q] - positions_[p];
+                const auto side = glm::cross(edge, unit);
+                const auto sideLength = glm::length(side);
+                if (sideLength == 0.0f) {
+                    continue;
+                }
+                const auto sideUnit = side / sideLength;
+                const auto weight = glm::dot(edge, edge) * borderWeight;
+                quadrics_[canonical_[p]].addPlane(sideUnit, -glm::dot(sideUnit, positions_[p]), weight);
+                quadrics_[canonical_[q]].addPlane(sideUnit, -glm::dot(sideUnit, positions_[p]), weight);
+            }
+        }
+    }
+
+    // Wedge of to's position connected to from's other wedge, for seams.
+    int64_t seamPair(uint32_t from, uint32_t to) const
+    {
+        const auto otherFrom = wedge_[from];
+        for (auto w = wedge_[to]; w != to; w = wedge_[w]) {
+            if (hasEdge(otherFrom, w) || hasEdge(w, otherFrom)) {
+                return w;
+            }
+        }
+        return -1;
+    }
+
+    // a->b is a half edge of the mesh.
+    bool allowed(uint32_t from, uint32_t to, uint32_t a, uint32_t b) const
+    {
+        switch (kinds_[canonical_[from]]) {
+        case Kind::Manifold:
+            return true;
+        case Kind::Border:
+            return !hasPositionEdge(b, a);
+        case Kind::Seam:
+            return hasPositionEdge(b, a) && !hasEdge(b, a) && seamPair(from, to) >= 0;
+        default:
+            return false;
+        }
+    }
+
+    bool flips(uint32_t from, uint32_t to, const std::vector<uint32_t> &triangles) const
+    {
+        const auto c0 = canonical_[from];
+        const auto c1 = canonical_[to];
+        for (const auto t : triangles) {
+            uint32_t corners[3];
+            bool hasTarget = false;
+            for (int k = 0; k < 3; k++) {
+                corners[k] = canonical_[indices_[t * 3 + k]];
+                hasTarget |= corners[k] == c1;
+            }
+            if (hasTarget) {
+                continue;
+            }
+
+            const auto before = normal(corners[0], corners[1], corners[2]);
+            for (auto &c : corners) {
+                c = c == c0 ? c1 : c;
+            }
+            const auto after = normal(corners[0], corners[1], corners[2]);
+            if (glm::dot(before, after) <= 0.0f) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool pass(size_t trianglesToRemove, float maxError2, float *resultError2)
+    {
+        // Triangles around every position.
+        std::vector<uint32_t> offsets(positions_.size() + 1, 0);
+        for (const auto index : indices_) {
+            offsets[canonical_[index] + 1]++;
+        }
+        for (size_t v = 0; v < positions_.size(); v++) {
+            offsets[v + 1] += offsets[v];
+        }
+        std::vector<uint32_t> adjacency(indices_.size());
+        {
+            auto cursors = offsets;
+            for (size_t i = 0; i < indices_.size(); i++) {
+                adjacency[cursors[canonical_[indices_[i]]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+        const auto trianglesAround = [&](uint32_t c) {
+            return std::vector<uint32_t>(adjacency.begin() + offsets[c], adjacency.begin() + offsets[c + 1]);
+        };
+
+        std::vector<Collapse> collapses;
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                const auto a = indices_[t + k];
+                const auto b = indices_[t + (k + 1) % 3];
+                for (const auto &[from, to] : { std::pair{ a, b }, std::pair{ b, a } }) {
+                    if (!allowed(from, to, a, b)) {
+                        continue;
+                    }
+                    auto q = quadrics_[canonical_[from]];
+                    q.add(quadrics_[canonical_[to]]);
+                    collapses.push_back(Collapse{ from, to, q.evaluate(positions_[to]) });
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+            [](const Collapse &x, const Collapse &y) { return x.error < y.error; });
+
+        std::vector<uint32_t> remap(positions_.size());
+        for (uint32_t v = 0; v < remap.size(); v++) {
+            remap[v] = v;
+        }
+        std::vector<uint8_t> locked(positions_.size(), 0);
+
+        size_t removed = 0;
+        bool collapsed = false;
+        for (const auto &collapse : collapses) {
+            if (collapse.error > maxError2 || removed >= trianglesToRemove) {
+                break;
+            }
+
+            const auto c0 = canonical_[collapse.from];
+            const auto c1 = canonical_[collapse.to];
+            if (locked[c0] || locked[c1]) {
+                continue;
+            }
+
+            const auto triangles = trianglesAround(c0);
+            if (flips(collapse.from, collapse.to, triangles)) {
+                continue;
+            }
+
+            remap[collapse.from] = collapse.to;
+            if (kinds_[c0] == Kind::Seam) {
+                remap[wedge_[collapse.from]] = static_cast<uint32_t>(seamPair(collapse.from, collapse.to));
+            }
+            quadrics_[c1].add(quadrics_[c0]);
+
+            // The one ring of c0 changes shape, its collapses are evaluated again next pass.
+            for (const auto t : triangles) {
+                bool hasTarget = false;
+                for (int k = 0; k < 3; k++) {
+                    const auto c = canonical_[indices_[t * 3 + k]];
+                    locked[c] = 1;
+                    hasTarget |= c == c1;
+                }
+                removed += hasTarget ? 1 : 0;
+            }
+
+            *resultError2 = std::max(*resultError2, collapse.error);
+            collapsed = true;
+        }
+
+        for (auto &index : indices_) {
+            index = remap[index];
+        }
+        return collapsed;
+    }
+};
+
+}
+
+std::vector<uint32_t> simplify(const MeshView &mesh, size_t targetIndicesCount, float maxError, float *error)
+{
+    return Simplifier{ mesh }.run(targetIndicesCount, maxError, error);
+}
+
+LodChain buildLodChain(const MeshView &mesh, const LodOptions &options)
+{
+    LodChain chain;
+    chain.push_back(LodLevel{ {}, 0.0f });
+    for (size_t i = 0; i < mesh.trianglesCount() * 3; i++) {
+        chain[0].indices.push_back(mesh.index(i));
+    }
+
+    // Every level simplifies the previous one, errors add up.
+    for (int level = 1; level < options.levelsCount; level++) {
+        const auto &previous = chain.back();
+        const auto target = static_cast<size_t>(previous.indices.size() / 3 * options.ratio) * 3;
+
+        float error = 0.0f;
+        auto indices = simplify(mesh.withIndices(previous.indices.data(), previous.indices.size()), target,
+            options.maxError - previous.error, &error);
+        if (indices.size() == previous.indices.size()) {
+            break;
+        }
+
+        chain.push_back(LodLevel{ std::move(indices), previous.error + error });
+    }
+    return chain;
+}
+
+std::vector<LodChain> buildLodChains(const std::vector<MeshView> &meshes, const LodOptions &options,
+    ThreadPool *pool)
+{
+    std::vector<LodChain> chains(meshes.size());
+    const auto build = [&](size_t i) { chains[i] = buildLodChain(meshes[i], options); };
+    if (pool) {
+        pool->parallelFor(meshes.size(), 1, build);
+    } else {
+        for (size_t i = 0; i < meshes.size(); i++) {
+            build(i);
+        }
+    }
+    return chains;
+}
+
+size_t selectLod(const LodChain &chain, float pixelsPerUnit, float maxErrorPixels)
+{
+    for (auto i = chain.size(); i > 1; i--) {
+        if (chain[i - 1].error * pixelsPerUnit <= maxErrorPixels) {
+            return i - 1;
+        }
+    }
+    return 0;
+}
+
+}
+
+}
@@ -0,0 +1,244 @@
+#include "gmt/mesh/Skinning.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "gmt/ThreadPool.h"
+
+namespace gmt
+{
+
+namespace mesh
+{
+
+namespace
+{
+
+// Vertices blended at once into the stack arrays, the blending loops vectorize across them.
+constexpr size_t blockSize = 64;
+
+// Vertices per parallel task.
+constexpr size_t parallelGrain = 16384;
+
+void writeNormal(float *destination, float x, float y, float z)
+{
+    const auto length = std::sqrt(x * x + y * y + z * z);
+    const auto scale = length > 0.0f ? 1.0f / length : 0.0f;
+    destination[0] = x * scale;
+    destination[1] = y * scale;
+    destination[2] = z * scale;
+}
+
+void skinLinear(const SkinInput &input, const MatrixPalette &palette, const SkinOutput &output,
+    size_t begin, size_t end)
+{
+    const auto *bones = input.bones;
+    const auto *weights = input.weights;
+
+    float m[12][blockSize];
+    for (auto block = begin; block < end; block += blockSize) {
+        const auto count = std::min(blockSize, end - block);
+
+        for (int k = 0; k < 12; k++) {
+            const auto *row = palette.rows[k].data();
+            for (size_t j = 0; j < count; j++) {
+                const auto &b = bones[block + j];
+                const auto &w = weights[block + j];
+                m[k][j] = row[b.x] * w.x + row[b.y] * w.y + row[b.z] * w.z + row[b.w] * w.w;
+            }
+        }
+
+        for (size_t j = 0; j < count; j++) {
+            const auto &p = input.positions[block + j];
+            auto *destination = output.position(block + j);
+            destination[0] = m[0][j] * p.x + m[1][j] * p.y + m[2][j] * p.z + m[3][j];
+            destination[1] = m[4][j] * p.x + m[5][j] * p.y + m[6][j] * p.z + m[7][j];
+            destination[2] = m[8][j] * p.x + m[9][j] * p.y + m[10][j] * p.z + m[11][j];
+        }
+
+        if (input.normals && output.hasNormals()) {
+            for (size_t j = 0; j < count; j++) {
+                const auto &n = input.normals[block + j];
+                writeNormal(output.normal(block + j),
+                    m[0][j] * n.x + m[1][j] * n.y + m[2][j] * n.z,
+                    m[4][j] * n.x + m[5][j] * n.y + m[6][j] * n.z,
+                    m[8][j] * n.x + m[9][j] * n.y + m[10][j] * n.z);
+            }
+        }
+    }
+}
+
+void skinDualQuaternion(const SkinInput &input, const DualQuaternionPalette &palette,
+    const SkinOutput &output, size_t begin, size_t end)
+{
+    const float *real[4] = { palette.realX.data(), palette.realY.data(), palette.realZ.data(), palette.realW.data() };
+    const float *dual[4] = { palette.dualX.data(), palette.dualY.data(), palette.dualZ.data(), palette.dualW.data() };
+    const auto *bones = input.bones;
+    const auto *weights = input.weights;
+
+    float r[4][blockSize];
+    float d[4][blockSize];
+    float w[4][blockSize];
+    for (auto block = begin; block < end; block += blockSize) {
+        const auto count = std::min(blockSize, end - block);
+
+        // q and -q are the same rotation, influences in the other hemisphere than the first one
+        // are negated so the blend doesn't pass through zero.
+        for (size_t j = 0; j < count; j++) {
+            const auto &b = bones[block + j];
+            const auto &weight = weights[block + j];
+            for (int i = 0; i < 4; i++) {
+                const auto dot = real[0][b[0]] * real[0][b[i]] + real[1][b[0]] * real[1][b[i]]
+                    + real[2][b[0]] * real[2][b[i]] + real[3][b[0]] * real[3][b[i]];
+                w[i][j] = dot < 0.0f ? -weight[i] : weight[i];
+            }
+        }
+
+        for (int k = 0; k < 4; k++) {
+            for (size_t j = 0; j < count; j++) {
+                const auto &b = bones[block + j];
+                r[k][j] = real[k][b.x] * w[0][j] + real[k][b.y] * w[1][j] + real[k][b.z] * w[2][j] + real[k][b.w] * w[3][j];
+                d[k][j] = dual[k][b.x] * w[0][j] + dual[k][b.y] * w[1][j] + dual[k][b.z] * w[2][j] + dual[k][b.w] * w[3][j];
+            }
+        }
+
+        // Influences that cancel out or zero weights leave the vertex in place.
+        for (size_t j = 0; j < count; j++) {
+            const auto length = std::sqrt(r[0][j] * r[0][j] + r[1][j] * r[1][j] + r[2][j] * r[2][j] + r[3][j] * r[3][j]);
+            const auto scale = length > 0.0f ? 1.0f / length : 0.0f;
+            for (int k = 0; k < 4; k++) {
+                r[k][j] *= scale;
+                d[k][j] *= scale;
+            }
+            r[3][j] += length > 0.0f ? 0.0f : 1.0f;
+        }
+
+        const auto rotate = [&r](size_t j, const glm::vec3 &v) {
+            const glm::vec3 q{ r[0][j], r[1][j], r[2][j] };
+            const auto t = 2.0f * glm::cross(q, v);
+            return v + r[3][j] * t + glm::cross(q, t);
+        };
+
+        for (size_t j = 0; j < count; j++) {
+            const glm::vec3 rv{ r[0][j], r[1][j], r[2][j] };
+            const glm::vec3 dv{ d[0][j], d[1][j], d[2][j] };
+            const auto translation = 2.0f * (r[3][j] * dv - d[3][j] * rv + glm::cross(rv, dv));
+            const auto p = rotate(j, input.positions[block + j]) + translation;
+
+            auto *destination = output.position(block + j);
+            destination[0] = p.x;
+            destination[1] = p.y;
+            destination[2] = p.z;
+        }
+
+        if (input.normals && output.hasNormals()) {
+            for (size_t j = 0; j < count; j++) {
+                const auto n = rotate(j, input.normals[block + j]);
+                writeNormal(output.normal(block + j), n.x, n.y, n.z);
+            }
+        }
+    }
+}
+
+template <typename Job, typename F>
+void skinJobs(const Job *jobs, size_t count, ThreadPool *pool, F &&kernel)
+{
+    if (!pool) {
+        for (size_t i = 0; i < count; i++) {
+            kernel(jobs[i], 0, jobs[i].input.count);
+        }
+        return;
+    }
+
+    // Large meshes are split so a single character doesn't keep one thread busy alone.
+    struct Chunk
+    {
+        const Job *job;
+        size_t begin;
+    };
+
+    std::vector<Chunk> chunks;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t begin = 0; begin < jobs[i].input.count; begin += parallelGrain) {
+            chunks.push_back({ &jobs[i], begin });
+        }
+    }
+
+    pool->parallelFor(chunks.size(), 1, [&chunks, &kernel](size_t i) {
+        const auto &chunk = chunks[i];
+        kernel(*chunk.job, chunk.begin, std::min(chunk.job->input.count, chunk.begin + parallelGrain));
+    });
+}
+
+}
+
+void MatrixPalette::resize(size_t size)
+{
+    // New bones are identities.
+    for (int k = 0; k < 12; k++) {
+        rows[k].resize(size, k % 5 == 0 ? 1.0f : 0.0f);
+    }
+}
+
+void MatrixPalette::set(size_t bone, const glm::mat4 &matrix)
+{
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) {
+            rows[r * 4 + c][bone] = matrix[c][r];
+        }
+    }
+}
+
+void DualQuaternionPalette::resize(size_t size)
+{
+    for (auto *v : { &realX, &realY, &realZ, &dualX, &dualY, &dualZ, &dualW }) {
+        v->resize(size);
+    }
+    realW.resize(size, 1.0f);
+}
+
+void DualQuaternionPalette::set(size_t bone, const glm::quat &rotation, const glm::vec3 &translation)
+{
+    const glm::vec3 v{ rotation.x, rotation.y, rotation.z };
+    const auto dual = 0.5f * (rotation.w * translation + glm::cross(translation, v));
+
+    realX[bone] = rotation.x;
+    realY[bone] = rotation.y;
+    realZ[bone] = rotation.z;
+    realW[bone] = rotation.w;
+    dualX[bone] = dual.x;
+    dualY[bone] = dual.y;
+    dualZ[bone] = dual.z;
+    dualW[bone] = -0.5f * glm::dot(translation, v);
+}
+
+void skinLinear(const SkinInput &input, const MatrixPalette &palette, const SkinOutput &output)
+{
+    skinLinear(input, palette, output, 0, input.count);
+}
+
+void skinDualQuaternion(const SkinInput &input, const DualQuaternionPalette &palette, const SkinOutput &output)
+{
+    skinDualQuaternion(input, palette, output, 0, input.count);
+}
+
+void skin(const LinearSkinJob *jobs, size_t count, ThreadPool *pool)
+{
+    skinJobs(jobs, count, pool, [](const LinearSkinJob &job, size_t begin, size_t end) {
+        assert(job.palette);
+        skinLinear(job.input, *job.palette, job.output, begin, end);
+    });
+}
+
+void skin(const DualQuaternionSkinJob *jobs, size_t count, ThreadPool *pool)
+{
+    skinJobs(jobs, count, pool, [](const DualQuaternionSkinJob &job, size_t begin, size_t end) {
+        assert(job.palette);
+        skinDualQuaternion(job.input, *job.palette, job.output, begin, end);
+    });
+}
+
+}
+
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <gmt/math/Bounds.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace bounds
+{
+
+namespace
+{
+
+void expectNear(const glm::vec3 &a, const glm::vec3 &b)
+{
+    EXPECT_NEAR(a.x, b.x, 0.0001f);
+    EXPECT_NEAR(a.y, b.y, 0.0001f);
+    EXPECT_NEAR(a.z, b.z, 0.0001f);
+}
+
+const Aabb unit{ glm::vec3{ -1.0f }, glm::vec3{ 1.0f } };
+
+}
+
+TEST(Aabb, GrowAndMerge)
+{
+    Aabb box;
+    EXPECT_TRUE(box.empty());
+    EXPECT_EQ(box.area(), 0.0f);
+
+    box.grow({ 1.0f, 2.0f, 3.0f });
+    box.grow({ -1.0f, 0.0f, 5.0f });
+    EXPECT_FALSE(box.empty());
+    expectNear(box.min, { -1.0f, 0.0f, 3.0f });
+    expectNear(box.max, { 1.0f, 2.0f, 5.0f });
+    EXPECT_NEAR(box.area(), 24.0f, 0.0001f);
+
+    const auto merged = box.merged(unit);
+    expectNear(merged.min, { -1.0f, -1.0f, -1.0f });
+    expectNear(merged.max, { 1.0f, 2.0f, 5.0f });
+    EXPECT_TRUE(merged.contains(box));
+    EXPECT_TRUE(merged.contains(unit));
+    EXPECT_FALSE(unit.contains(merged));
+}
+
+TEST(Aabb, Transformed)
+{
+    const auto m = glm::rotate(glm::translate(glm::mat4{ 1.0f }, { 5.0f, 0.0f, 0.0f }),
+        glm::radians(45.0f), glm::vec3{ 0.0f, 0.0f, 1.0f });
+    const auto box = unit.transformed(m);
+    const auto r = std::sqrt(2.0f);
+    expectNear(box.min, { 5.0f - r, -r, -1.0f });
+    expectNear(box.max, { 5.0f + r, r, 1.0f });
+
+    EXPECT_TRUE(Aabb{}.transformed(m).empty());
+}
+
+TEST(Aabb, Overlaps)
+{
+    EXPECT_TRUE(unit.overlaps(Aabb{ glm::vec3{ 0.5f }, glm::vec3{ 2.0f } }));
+    EXPECT_TRUE(unit.overlaps(Aabb{ glm::vec3{ 1.0f }, glm::vec3{ 2.0f } }));
+    EXPECT_FALSE(unit.overlaps(Aabb{ glm::vec3{ 1.5f }, glm::vec3{ 2.0f } }));
+
+    EXPECT_TRUE(unit.overlaps(Sphere{ { 2.0f, 0.0f, 0.0f }, 1.5f }));
+    EXPECT_FALSE(unit.overlaps(Sphere{ { 2.0f, 2.0f, 0.0f }, 1.2f }));
+    EXPECT_TRUE(unit.contains(Sphere{ {}, 1.0f }));
+    EXPECT_FALSE(unit.contains(Sphere{ {}, 1.1f }));
+}
+
+TEST(Aabb, Outside)
+{
+    const Plane plane{ { 2.0f, 0.0f, 0.0f }, { 2.0f, 1.0f, 0.0f }, { 2.0f, 0.0f, 1.0f } };
+    ASSERT_GT(plane.normal().x, 0.0f);
+    EXPECT_TRUE(unit.outside(plane));
+    EXPECT_FALSE(Aabb({ glm::vec3{ 1.5f }, glm::vec3{ 2.5f } }).outside(plane));
+}
+
+TEST(Sphere, FromPoints)
+{
+    const glm::vec3 points[] = {
+        { -1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f },
+        { 0.5f, 0.5f, 0.5f }
+    };
+    const auto sphere = Sphere::fromPoints(points, std::size(points));
+    for (const auto &p : points) {
+        EXPECT_TRUE(sphere.contains(p));
+    }
+    EXPECT_LT(sphere.radius, 1.1f);
+    EXPECT_LT(Sphere::fromPoints(points, 0).radius, 0.0f);
+}
+
+TEST(Sphere, Merge)
+{
+    const Sphere a{ { -1.0f, 0.0f, 0.0f }, 1.0f };
+    const Sphere b{ { 2.0f, 0.0f, 0.0f }, 1.0f };
+    const auto merged = a.merged(b);
+    expectNear(merged.center, { 0.5f, 0.0f, 0.0f });
+    EXPECT_NEAR(merged.radius, 2.5f, 0.0001f);
+    EXPECT_TRUE(merged.contains(a));
+    EXPECT_TRUE(merged.contains(b));
+
+    EXPECT_EQ(Sphere{}.merged(a).radius, a.radius);
+    EXPECT_EQ(merged.merged(a).radius, merged.radius);
+}
+
+TEST(Sphere, Transformed)
+{
+    const auto m = glm::scale(glm::translate(glm::mat4{ 1.0f }, { 0.0f, 3.0f, 0.0f }), { 1.0f, 2.0f, 1.0f });
+    const auto sphere = Sphere{ { 1.0f, 0.0f, 0.0f }, 1.0f }.transformed(m);
+    expectNear(sphere.center, { 1.0f, 3.0f, 0.0f });
+    EXPECT_NEAR(sphere.radius, 2.0f, 0.0001f);
+    EXPECT_TRUE(sphere.overlaps(Sphere{ { 1.0f, 6.0f, 0.0f }, 1.0f }));
+    EXPECT_FALSE(sphere.overlaps(Sphere{ { 1.0f, 6.5f, 0.0f }, 1.0f }));
+}
+
+TEST(Obb, Bounds)
+{
+    const auto m = glm::rotate(glm::mat4{ 1.0f }, glm::radians(45.0f), glm::vec3{ 0.0f, 1.0f, 0.0f });
+    const auto obb = Obb::fromAabb(unit, m);
+    const auto r = std::sqrt(2.0f);
+    const auto box = obb.bounds();
+    expectNear(box.min, { -r, -1.0f, -r });
+    expectNear(box.max, { r, 1.0f, r });
+
+    EXPECT_TRUE(obb.contains({ 0.0f, 0.0f, 1.3f }));
+    EXPECT_FALSE(obb.contains({ 1.0f, 0.0f, 1.0f }));
+}
+
+TEST(Obb, Overlaps)
+{
+    const auto rotation = glm::rotate(glm::mat4{ 1.0f }, glm::radians(45.0f), glm::vec3{ 0.0f, 0.0f, 1.0f });
+    const auto moved = [&rotation](float x) {
+        return Obb::fromAabb(unit, glm::translate(glm::mat4{ 1.0f }, { x, 0.0f, 0.0f }) * rotation);
+    };
+
+    // The rotated box reaches sqrt(2) along x.
+    EXPECT_TRUE(moved(2.3f).overlaps(unit));
+    EXPECT_FALSE(moved(2.5f).overlaps(unit));
+    EXPECT_TRUE(moved(2.3f).overlaps(Obb::fromAabb(unit)));
+
+    // Separated only by an edge-edge axis.
+    const auto a = Obb::fromAabb(unit, glm::rotate(glm::mat4{ 1.0f }, glm::radians(45.0f), glm::vec3{ 1.0f, 0.0f, 0.0f }));
+    const auto b = Obb::fromAabb(unit, glm::translate(glm::mat4{ 1.0f }, { 0.0f, 2.0f, 2.0f })
+        * glm::rotate(glm::mat4{ 1.0f }, glm::radians(45.0f), glm::vec3{ 0.0f, 1.0f, 0.0f }));
+    EXPECT_FALSE(a.overlaps(b));
+    EXPECT_TRUE(a.overlaps(Sphere{ { 0.0f, 0.0f, 2.0f }, 0.7f }));
+    EXPECT_FALSE(a.overlaps(Sphere{ { 0.0f, 0.0f, 2.0f }, 0.5f }));
+}
+
+TEST(Bounds, BatchMatchesScalar)
+{
+    AabbArray boxes;
+    SphereArray spheres;
+    for (int i = 0; i < 37; i++) {
+        const auto c = glm::vec3{ i * 0.5f - 9.0f, std::sin(i * 1.0f) * 3.0f, std::cos(i * 1.0f) * 3.0f };
+        boxes.push_back(Aabb::fromCenterExtents(c, glm::vec3{ 0.25f + (i % 3) * 0.5f }));
+        spheres.push_back(Sphere{ c, 0.25f + (i % 4) * 0.5f });
+    }
+
+    const auto m = glm::rotate(glm::translate(glm::mat4{ 1.0f }, { 1.0f, 2.0f, 3.0f }),
+        glm::radians(30.0f), glm::normalize(glm::vec3{ 1.0f, 1.0f, 0.0f }));
+    AabbArray transformedBoxes;
+    SphereArray transformedSpheres;
+    gmt::bounds::transform(boxes, m, &transformedBoxes);
+    gmt::bounds::transform(spheres, m, &transformedSpheres);
+    ASSERT_EQ(transformedBoxes.size(), boxes.size());
+    ASSERT_EQ(transformedSpheres.size(), spheres.size());
+
+    const Plane planes[] = {
+        Plane{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+        Plane{ { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 0.0f } },
+        // Skipped, e.g. the far plane of an infinite projection.
+        Plane{},
+    };
+    const Aabb queryBox{ glm::vec3{ -2.0f }, glm::vec3{ 2.0f } };
+    const Sphere querySphere{ {}, 3.0f };
+
+    uint8_t boxOverlaps[37];
+    uint8_t sphereOverlaps[37];
+    uint8_t boxPlanes[37];
+    uint8_t spherePlanes[37];
+    gmt::bounds::overlaps(boxes, queryBox, boxOverlaps);
+    gmt::bounds::overlaps(spheres, querySphere, sphereOverlaps);
+    gmt::bounds::intersectsPlanes(boxes, planes, std::size(planes), boxPlanes);
+    gmt::bounds::intersectsPlanes(spheres, planes, std::size(planes), spherePlanes);
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+        const auto box = boxes.get(i);
+        const auto sphere = spheres.get(i);
+
+        const auto expectedBox = box.transformed(m);
+        expectNear(transformedBoxes.get(i).min, expectedBox.min);
+        expectNear(transformedBoxes.get(i).max, expectedBox.max);
+        const auto expectedSphere = sphere.transformed(m);
+        expectNear(transformedSpheres.get(i).center, expectedSphere.center);
+        EXPECT_NEAR(transformedSpheres.get(i).radius, expectedSphere.radius, 0.0001f);
+
+        EXPECT_EQ(boxOverlaps[i] != 0, box.overlaps(queryBox));
+        EXPECT_EQ(sphereOverlaps[i] != 0, sphere.overlaps(querySphere));
+        EXPECT_EQ(boxPlanes[i] != 0, !box.outside(planes[0]) && !box.outside(planes[1]));
+        EXPECT_EQ(spherePlanes[i] != 0, !sphere.outside(planes[0]) && !sphere.outside(planes[1]));
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <gmt/math/Bvh.h>
+#include <gmt/ThreadPool.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace bvh
+{
+
+namespace
+{
+
+struct Mesh
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+
+    MeshView view() const { return MeshView{ positions.data(), positions.size(), indices.data(), indices.size() }; }
+};
+
+Mesh randomTriangles(size_t count, unsigned seed)
+{
+    std::mt19937 engine{ seed };
+    std::uniform_real_distribution<float> center{ -10.0f, 10.0f };
+    std::uniform_real_distribution<float> offset{ -1.0f, 1.0f };
+
+    Mesh mesh;
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec3 c{ center(engine), center(engine), center(engine) };
+        for (int k = 0; k < 3; k++) {
+            mesh.indices.push_back(static_cast<uint32_t>(mesh.positions.size()));
+            mesh.positions.push_back(c + glm::vec3{ offset(engine), offset(engine), offset(engine) });
+        }
+    }
+    return mesh;
+}
+
+std::vector<Ray> randomRays(size_t count, unsigned seed)
+{
+    std::mt19937 engine{ seed };
+    std::uniform_real_distribution<float> point{ -12.0f, 12.0f };
+
+    std::vector<Ray> rays;
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec3 s{ point(engine), point(engine), point(engine) };
+        const glm::vec3 t{ point(engine), point(engine), point(engine) };
+        rays.push_back(Ray::fromPoints(s, t));
+    }
+    return rays;
+}
+
+bool bruteForce(const Mesh &mesh, const Ray &ray, BvhHit *hit)
+{
+    bool found = false;
+    auto closest = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < mesh.indices.size() / 3; i++) {
+        RayHit h;
+        const auto &p = mesh.positions;
+        const auto *t = &mesh.indices[i * 3];
+        if (gmt::ray::intersectsTriangle(ray, p[t[0]], p[t[1]], p[t[2]], &h, closest)) {
+            closest = h.t;
+            *hit = BvhHit{ h.t, h.u, h.v, static_cast<uint32_t>(i) };
+            found = true;
+        }
+    }
+    return found;
+}
+
+void expectMatchesBruteForce(const Mesh &mesh, const Bvh &bvh)
+{
+    for (const auto &ray : randomRays(500, 7)) {
+        BvhHit expected;
+        BvhHit actual;
+        const auto found = bruteForce(mesh, ray, &expected);
+        ASSERT_EQ(bvh.intersect(ray, &actual), found);
+        EXPECT_EQ(bvh.occluded(ray), found);
+        if (found) {
+            EXPECT_NEAR(actual.t, expected.t, 0.0001f);
+            EXPECT_EQ(actual.triangle, expected.triangle);
+        }
+    }
+}
+
+}
+
+TEST(Bvh, Empty)
+{
+    Bvh bvh;
+    BvhHit hit;
+    EXPECT_TRUE(bvh.empty());
+    EXPECT_FALSE(bvh.intersect(Ray{ {}, { 0.0f, 0.0f, 1.0f } }, &hit));
+    EXPECT_FALSE(bvh.occluded(Ray{ {}, { 0.0f, 0.0f, 1.0f } }));
+}
+
+TEST(Bvh, MatchesBruteForce)
+{
+    const auto mesh = randomTriangles(1000, 1);
+    const Bvh bvh{ mesh.view() };
+    EXPECT_FALSE(bvh.empty());
+    expectMatchesBruteForce(mesh, bvh);
+}
+
+TEST(Bvh, ParallelBuild)
+{
+    const auto mesh = randomTriangles(5000, 2);
+    ThreadPool pool{ 3 };
+
+    BvhBuildOptions options;
+    options.pool = &pool;
+    options.parallelThreshold = 256;
+    const Bvh bvh{ mesh.view(), options };
+    expectMatchesBruteForce(mesh, bvh);
+
+    const Bvh serial{ mesh.view() };
+    EXPECT_EQ(bvh.nodes().size(), serial.nodes().size());
+}
+
+TEST(Bvh, Occluded)
+{
+    Mesh mesh;
+    mesh.positions = { { -1.0f, -1.0f, 0.0f }, { 1.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    mesh.indices = { 0, 1, 2 };
+    const Bvh bvh{ mesh.view() };
+
+    const auto ray = Ray{ { 0.0f, 0.0f, 2.0f }, { 0.0f, 0.0f, -1.0f } };
+    EXPECT_TRUE(bvh.occluded(ray));
+    EXPECT_FALSE(bvh.occluded(ray, 1.5f));
+    EXPECT_TRUE(bvh.occluded(ray, std::numeric_limits<float>::max(), gmt::ray::Culling::BackFaces));
+
+    const auto back = Ray{ { 0.0f, 0.0f, -2.0f }, { 0.0f, 0.0f, 1.0f } };
+    EXPECT_TRUE(bvh.occluded(back));
+    EXPECT_FALSE(bvh.occluded(back, std::numeric_limits<float>::max(), gmt::ray::Culling::BackFaces));
+}
+
+TEST(Bvh, InterleavedVertices)
+{
+    struct Vertex
+    {
+        glm::vec2 uv;
+        glm::vec3 position;
+        glm::vec3 normal;
+    };
+
+    const Vertex vertices[] = {
+        { {}, { -1.0f, -1.0f, 0.0f }, {} },
+        { {}, { 1.0f, -1.0f, 0.0f }, {} },
+        { {}, { 1.0f, 1.0f, 0.0f }, {} },
+        { {}, { -1.0f, 1.0f, 0.0f }, {} },
+    };
+    const uint16_t indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    const Bvh bvh{ MeshView{ vertices, 4, indices, 6, &Vertex::position } };
+
+    BvhHit hit;
+    ASSERT_TRUE(bvh.intersect(Ray{ { -0.5f, 0.5f, 1.0f }, { 0.0f, 0.0f, -1.0f } }, &hit));
+    EXPECT_EQ(hit.triangle, 1u);
+    EXPECT_NEAR(hit.t, 1.0f, 0.00001f);
+    EXPECT_FALSE(bvh.intersect(Ray{ { 2.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } }, &hit));
+}
+
+}
+
+}
+
+}
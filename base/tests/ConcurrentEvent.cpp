@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gmt/ConcurrentEvent.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace concurrent_event
+{
+
+TEST(ConcurrentEvent, AttachDetach)
+{
+    ConcurrentEvent<int> event;
+
+    int sum = 0;
+    auto first = event.attach([&sum](int i) { sum += i; });
+    auto second = event.attach([&sum](int i) { sum += 10 * i; });
+    EXPECT_EQ(event.getListenersCount(), 2u);
+
+    event(1);
+    EXPECT_EQ(sum, 11);
+
+    first.detach();
+    event(1);
+    EXPECT_EQ(sum, 21);
+    EXPECT_EQ(event.getListenersCount(), 1u);
+
+    {
+        auto moved = std::move(second);
+    }
+    event(1);
+    EXPECT_EQ(sum, 21);
+    EXPECT_EQ(event.getListenersCount(), 0u);
+}
+
+TEST(ConcurrentEvent, ModifyWhileTriggered)
+{
+    ConcurrentEvent<> event;
+
+    // Attach and detach from a callback, the snapshots are retired instead of waited for.
+    int invocationCount = 0;
+    ConcurrentEvent<>::ListenerPtr self;
+    ConcurrentEvent<>::ListenerPtr attached;
+    self = event.attach([&]() {
+        invocationCount += 1;
+        attached = event.attach([&invocationCount]() { invocationCount += 10; });
+        self.detach();
+    });
+
+    event();
+    EXPECT_EQ(invocationCount, 1);
+
+    event();
+    EXPECT_EQ(invocationCount, 11);
+    EXPECT_EQ(event.getListenersCount(), 1u);
+}
+
+TEST(ConcurrentEvent, Threads)
+{
+    ConcurrentEvent<> event;
+    std::atomic<int> permanentCalls{ 0 };
+    auto permanent = event.attach([&permanentCalls]() { permanentCalls++; });
+
+    constexpr int triggers = 20000;
+    std::atomic<bool> stop{ false };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; i++) {
+        threads.emplace_back([&event]() {
+            for (int j = 0; j < triggers; j++) {
+                event();
+            }
+        });
+    }
+    for (int i = 0; i < 2; i++) {
+        threads.emplace_back([&event, &stop]() {
+            std::atomic<int> calls{ 0 };
+            while (!stop.load()) {
+                auto listener = event.attach([&calls]() { calls++; });
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    for (int i = 0; i < 3; i++) {
+        threads[i].join();
+    }
+    stop = true;
+    for (size_t i = 3; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    EXPECT_EQ(permanentCalls.load(), 3 * triggers);
+    EXPECT_EQ(event.getListenersCount(), 1u);
+}
+
+}
+
+}
+
+}
@@ -1,5 +1,11 @@
 #include "gtest/gtest.h"
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "gmt/Event.h"
 
 using namespace gmt;
@@ -288,4 +294,235 @@ TEST(Event, MoveIntoEventWithListeners)
 
 		// myListener is destroyed here, shall see that original anotherEvent is destroyed.
 	}
-}
\ No newline at end of file
+}
+
+TEST(Event, DetachWhileTriggered)
+{
+	Event<> myEvent;
+
+	int invocationCount = 0;
+	Event<>::ListenerPtr first;
+	Event<>::ListenerPtr second;
+	first = myEvent.attach([&]()
+	{
+		invocationCount += 1;
+		first.detach();
+		second.detach();
+	});
+	second = myEvent.attach([&invocationCount]()
+	{
+		invocationCount += 10;
+	});
+
+	myEvent();
+	myEvent();
+
+	EXPECT_EQ(invocationCount, 1);
+	EXPECT_EQ(myEvent.getListenersCount(), 0);
+}
+
+TEST(Event, AttachWhileTriggered)
+{
+	Event<> myEvent;
+
+	int invocationCount = 0;
+	std::vector<Event<>::ListenerPtr> listeners;
+	listeners.push_back(myEvent.attach([&]()
+	{
+		// Enough listeners to grow the storage, they are called from the next trigger on.
+		for (int i = 0; i < 100; i++) {
+			listeners.push_back(myEvent.attach([&invocationCount]()
+			{
+				invocationCount += 1;
+			}));
+		}
+	}));
+
+	myEvent();
+	EXPECT_EQ(invocationCount, 0);
+	EXPECT_EQ(myEvent.getListenersCount(), 101);
+
+	listeners.resize(1);
+	listeners[0].detach();
+	myEvent();
+	EXPECT_EQ(invocationCount, 0);
+	EXPECT_EQ(myEvent.getListenersCount(), 0);
+}
+
+TEST(Event, OrderAfterCompaction)
+{
+	Event<int> myEvent;
+
+	std::vector<int> calls;
+	std::vector<Event<int>::ListenerPtr> listeners;
+	for (int i = 0; i < 10; i++) {
+		listeners.push_back(myEvent.attach([&calls, i](int)
+		{
+			calls.push_back(i);
+		}));
+	}
+	for (int i = 0; i < 10; i += 2) {
+		listeners[i].detach();
+	}
+
+	// Reuses a freed id, but goes last.
+	listeners.push_back(myEvent.attach([&calls](int)
+	{
+		calls.push_back(10);
+	}));
+
+	myEvent(0);
+	EXPECT_EQ(calls, (std::vector<int>{ 1, 3, 5, 7, 9, 10 }));
+}
+
+TEST(Event, StaleListener)
+{
+	Event<> myEvent;
+
+	int invocationCount = 0;
+	auto myListener = myEvent.attach([]()
+	{
+	});
+	auto moved = std::move(myListener);
+	moved.detach();
+
+	// The new callback may reuse the id of the detached one, old handles mustn't detach it.
+	auto anotherListener = myEvent.attach([&invocationCount]()
+	{
+		invocationCount += 1;
+	});
+	myListener.detach();
+	moved.detach();
+
+	myEvent();
+
+	EXPECT_FALSE(moved);
+	EXPECT_TRUE(anotherListener);
+	EXPECT_EQ(invocationCount, 1);
+}
+
+TEST(Event, LargeCallable)
+{
+	Event<> myEvent;
+
+	int invocationCount = 0;
+	std::array<int, 64> payload{};
+	payload[63] = 2;
+	auto shared = std::make_shared<int>(0);
+	auto listener = myEvent.attach([&invocationCount, payload, shared]()
+	{
+		invocationCount += payload[63];
+	});
+
+	myEvent();
+	EXPECT_EQ(invocationCount, 2);
+	EXPECT_EQ(shared.use_count(), 2);
+
+	listener.detach();
+	EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(Event, AsyncOrder)
+{
+	ThreadPool pool{ 4 };
+	Event<int> myEvent;
+
+	std::mutex mutex;
+	std::vector<int> first;
+	std::vector<int> second;
+	auto firstListener = myEvent.attachAsync(pool, [&](int value)
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		first.push_back(value);
+	});
+	auto secondListener = myEvent.attachAsync(pool, [&](int value)
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		second.push_back(value);
+	});
+
+	std::vector<int> expected;
+	for (int i = 0; i < 100; i++) {
+		myEvent(i);
+		expected.push_back(i);
+	}
+	myEvent.join();
+
+	EXPECT_EQ(first, expected);
+	EXPECT_EQ(second, expected);
+}
+
+TEST(Event, AsyncFence)
+{
+	ThreadPool pool{ 2 };
+	Event<int> myEvent;
+
+	int syncValue = 0;
+	std::atomic<int> asyncValue{ 0 };
+	auto syncListener = myEvent.attach([&syncValue](int value) { syncValue = value; });
+	auto asyncListener = myEvent.attachAsync(pool, [&asyncValue](int value) { asyncValue += value; });
+
+	auto fence = myEvent(3);
+	EXPECT_EQ(syncValue, 3);
+	fence.wait();
+	EXPECT_TRUE(fence.ready());
+	EXPECT_EQ(asyncValue.load(), 3);
+
+	// Only sync callbacks, nothing to wait for.
+	asyncListener.detach();
+	EXPECT_TRUE(myEvent(4).ready());
+	EXPECT_EQ(asyncValue.load(), 3);
+}
+
+TEST(Event, AsyncDetach)
+{
+	ThreadPool pool{ 1 };
+	Event<> myEvent;
+
+	// Blocks the only worker, the async calls stay queued.
+	std::atomic<bool> release{ false };
+	auto blocker = pool.submit([&release]() {
+		while (!release.load()) {
+			std::this_thread::yield();
+		}
+	});
+
+	std::atomic<int> invocationCount{ 0 };
+	auto listener = myEvent.attachAsync(pool, [&invocationCount]() { invocationCount += 1; });
+	auto fence = myEvent();
+	myEvent();
+	EXPECT_FALSE(fence.ready());
+
+	// Queued calls are dropped, their fences complete.
+	listener.detach();
+	EXPECT_TRUE(fence.ready());
+	release = true;
+	blocker.wait();
+	myEvent.join();
+	EXPECT_EQ(invocationCount.load(), 0);
+}
+
+TEST(Event, AsyncJoinRunsQueued)
+{
+	ThreadPool pool{ 1 };
+	Event<int> myEvent;
+
+	std::atomic<bool> release{ false };
+	auto blocker = pool.submit([&release]() {
+		while (!release.load()) {
+			std::this_thread::yield();
+		}
+	});
+
+	// The worker is busy, join runs the calls on this thread.
+	int sum = 0;
+	auto listener = myEvent.attachAsync(pool, [&sum](int value) { sum += value; });
+	auto fence = myEvent(1);
+	myEvent(2);
+	myEvent.join();
+	EXPECT_TRUE(fence.ready());
+	EXPECT_EQ(sum, 3);
+
+	release = true;
+	blocker.wait();
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <gmt/EventQueue.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace event_queue
+{
+
+namespace
+{
+
+struct Resize
+{
+    int width{ 0 };
+    int height{ 0 };
+};
+
+}
+
+TEST(EventQueue, InOrder)
+{
+    EventQueue<int> queue{ EventCoalescing::None, 2 };
+
+    std::vector<int> received;
+    auto listener = queue.attach([&received](int value, size_t count) {
+        EXPECT_EQ(count, 1u);
+        received.push_back(value);
+    });
+
+    // Grows past the initial capacity, wrapped around.
+    queue.push(0);
+    queue.push(1);
+    EXPECT_EQ(queue.dispatch(), 2u);
+    for (int i = 2; i < 12; i++) {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.size(), 10u);
+    EXPECT_EQ(queue.dispatch(), 10u);
+    EXPECT_TRUE(queue.empty());
+
+    std::vector<int> expected(12);
+    for (int i = 0; i < 12; i++) {
+        expected[i] = i;
+    }
+    EXPECT_EQ(received, expected);
+}
+
+TEST(EventQueue, KeepLast)
+{
+    EventQueue<Resize> queue{ EventCoalescing::KeepLast };
+
+    int calls = 0;
+    auto listener = queue.attach([&calls](const Resize &resize, size_t count) {
+        EXPECT_EQ(resize.width, 300);
+        EXPECT_EQ(resize.height, 200);
+        EXPECT_EQ(count, 3u);
+        calls += 1;
+    });
+
+    queue.push({ 100, 100 });
+    queue.push({ 200, 100 });
+    queue.push({ 300, 200 });
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.pushedCount(), 3u);
+    EXPECT_EQ(queue.dispatch(), 1u);
+    EXPECT_EQ(queue.dispatch(), 0u);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(EventQueue, Merge)
+{
+    // Dirty rectangles united into one.
+    EventQueue<Resize> queue{ [](Resize &accumulated, const Resize &next) {
+        accumulated.width = std::max(accumulated.width, next.width);
+        accumulated.height = std::max(accumulated.height, next.height);
+    } };
+
+    queue.push({ 10, 50 });
+    queue.push({ 40, 20 });
+
+    Resize merged;
+    size_t mergedCount = 0;
+    EXPECT_EQ(queue.dispatch([&](const Resize &resize, size_t count) {
+        merged = resize;
+        mergedCount = count;
+    }), 1u);
+    EXPECT_EQ(merged.width, 40);
+    EXPECT_EQ(merged.height, 50);
+    EXPECT_EQ(mergedCount, 2u);
+}
+
+TEST(EventQueue, Count)
+{
+    EventQueue<Resize> queue{ EventCoalescing::Count };
+    for (int i = 0; i < 5; i++) {
+        queue.push({ i, i });
+    }
+
+    size_t received = 0;
+    queue.dispatch([&received](const Resize &, size_t count) { received = count; });
+    EXPECT_EQ(received, 5u);
+
+    queue.push({});
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.dispatch(), 0u);
+}
+
+TEST(EventQueue, PushWhileDispatching)
+{
+    EventQueue<int> queue;
+
+    std::vector<int> received;
+    auto listener = queue.attach([&](int value, size_t) {
+        received.push_back(value);
+        if (value < 100) {
+            queue.push(value + 100);
+        }
+    });
+
+    queue.push(1);
+    queue.push(2);
+    EXPECT_EQ(queue.dispatch(), 2u);
+    EXPECT_EQ(received, (std::vector<int>{ 1, 2 }));
+    EXPECT_EQ(queue.dispatch(), 2u);
+    EXPECT_EQ(received, (std::vector<int>{ 1, 2, 101, 102 }));
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Trace messages are compiled out in this file.
+#define GMT_LOG_MIN_LEVEL 1
+#include <gmt/Logger.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace logger
+{
+
+namespace
+{
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+// Not trivially copyable, formatted by the logging thread.
+struct Name
+{
+    std::string value;
+};
+
+// Logs into a file only, returns the logged messages without timestamps.
+template <typename F>
+std::vector<std::string> capture(F &&f)
+{
+    const std::string path = ::testing::TempDir() + "gmt_logger_test.log";
+    std::remove(path.c_str());
+
+    auto &logger = Logger::shared();
+    logger.setConsole(false);
+    EXPECT_TRUE(logger.setFile(path));
+    f(logger);
+    logger.setFile("");
+    logger.setConsole(true);
+
+    std::vector<std::string> messages;
+    std::ifstream file{ path };
+    for (std::string line; std::getline(file, line);) {
+        // "HH:MM:SS: message"
+        messages.push_back(line.size() >= 10 ? line.substr(10) : line);
+    }
+    std::remove(path.c_str());
+    return messages;
+}
+
+}
+
+}
+
+}
+
+}
+
+template <>
+struct gmt::LogByValue<gmt::tests::logger::Point> : std::true_type
+{
+};
+
+template <>
+struct fmt::formatter<gmt::tests::logger::Point> : fmt::formatter<int>
+{
+    template <typename Context>
+    auto format(const gmt::tests::logger::Point &p, Context &context) const
+    {
+        return fmt::format_to(context.out(), "({}, {})", p.x, p.y);
+    }
+};
+
+template <>
+struct fmt::formatter<gmt::tests::logger::Name> : fmt::formatter<std::string>
+{
+    template <typename Context>
+    auto format(const gmt::tests::logger::Name &name, Context &context) const
+    {
+        return fmt::format_to(context.out(), "<{}>", name.value);
+    }
+};
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace logger
+{
+
+TEST(Logger, Arguments)
+{
+    const auto messages = capture([](Logger &logger) {
+        std::string temporary = "string";
+        logger.log("a ", 1, ' ', 2.5, ' ', temporary, ' ', Point{ 3, 4 }, ' ', Name{ "name" });
+        // The copy is logged, not what the string holds later.
+        temporary = "changed";
+        logger.logf("{} + {} = {:03}", 1, 2, 3);
+        logger.logf(std::string{ "{}" }, std::string_view{ "view" });
+    });
+
+    ASSERT_EQ(messages.size(), 3u);
+    EXPECT_EQ(messages[0], "a 1 2.5 string (3, 4) <name>");
+    EXPECT_EQ(messages[1], "1 + 2 = 003");
+    EXPECT_EQ(messages[2], "view");
+}
+
+TEST(Logger, Views)
+{
+    const auto messages = capture([](Logger &logger) {
+        // The view points into the vector, it's formatted before the vector goes away.
+        {
+            std::vector<int> values{ 1, 2, 3 };
+            logger.log(fmt::join(values.begin(), values.end(), ", "));
+            values.assign(3, 0);
+        }
+        logger.flush();
+    });
+
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages[0], "1, 2, 3");
+}
+
+TEST(Logger, Overflow)
+{
+    // Longer than a thread's ring and enough to fill it, nothing is lost.
+    const std::string large(100000, 'x');
+    const auto messages = capture([&large](Logger &logger) {
+        logger.log(large);
+        for (int i = 0; i < 10000; i++) {
+            logger.log(i);
+        }
+    });
+
+    ASSERT_EQ(messages.size(), 10001u);
+    EXPECT_EQ(messages[0], large);
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_EQ(messages[i + 1], std::to_string(i));
+    }
+}
+
+TEST(Logger, Threads)
+{
+    constexpr int threadsCount = 4;
+    constexpr int messagesCount = 1000;
+
+    const auto messages = capture([](Logger &logger) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadsCount; i++) {
+            threads.emplace_back([&logger, i]() {
+                for (int j = 0; j < messagesCount; j++) {
+                    logger.logf("{} {}", i, j);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    });
+
+    // Every message once, in order within each thread.
+    ASSERT_EQ(messages.size(), size_t{ threadsCount * messagesCount });
+    std::vector<int> next(threadsCount, 0);
+    for (const auto &message : messages) {
+        int thread = 0;
+        int index = 0;
+        ASSERT_EQ(std::sscanf(message.c_str(), "%d %d", &thread, &index), 2);
+        EXPECT_EQ(index, next[thread]);
+        next[thread] = index + 1;
+    }
+}
+
+TEST(Logger, Levels)
+{
+    LogCategory category{ "test", LogLevel::Warning };
+
+    int evaluated = 0;
+    const auto count = [&evaluated]() { return ++evaluated; };
+    const auto messages = capture([&](Logger &) {
+        GMT_LOG_INFO(category, "info {}", count());
+        GMT_LOG_WARNING(category, "warning {}", count());
+        GMT_LOG_ERROR(category, "error {}", count());
+
+        category.setLevel(LogLevel::Trace);
+        GMT_LOG_TRACE(category, "trace {}", count());
+        GMT_LOG_DEBUG(category, "debug {}", count());
+
+        category.setLevel(LogLevel::None);
+        GMT_LOG_ERROR(category, "none {}", count());
+    });
+
+    // Arguments of skipped calls aren't evaluated.
+    EXPECT_EQ(evaluated, 3);
+    ASSERT_EQ(messages.size(), 3u);
+    EXPECT_EQ(messages[0], "warning test: warning 1");
+    EXPECT_EQ(messages[1], "error test: error 2");
+    EXPECT_EQ(messages[2], "debug test: debug 3");
+}
+
+TEST(Logger, FormatError)
+{
+    const auto messages = capture([](Logger &logger) {
+        logger.logf("{} {}", 1);
+    });
+
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages[0].rfind("<log format error", 0), 0u);
+}
+
+}
+
+}
+
+}
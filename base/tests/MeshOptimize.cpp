@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gmt/mesh/Optimize.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace mesh_optimize
+{
+
+namespace
+{
+
+// size x size quads in the z plane, facing +z.
+void appendGrid(int size, float z, std::vector<glm::vec3> *positions, std::vector<uint32_t> *indices)
+{
+    const auto base = static_cast<uint32_t>(positions->size());
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            positions->push_back({ static_cast<float>(x), static_cast<float>(y), z });
+        }
+    }
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const auto i = base + static_cast<uint32_t>(y * (size + 1) + x);
+            const auto up = i + static_cast<uint32_t>(size + 1);
+            indices->insert(indices->end(), { i, i + 1, up + 1, i, up + 1, up });
+        }
+    }
+}
+
+void shuffleTriangles(std::vector<uint32_t> *indices)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < indices->size(); i += 3) {
+        triangles.push_back({ (*indices)[i], (*indices)[i + 1], (*indices)[i + 2] });
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937{ 5 });
+    indices->clear();
+    for (const auto &t : triangles) {
+        indices->insert(indices->end(), t.begin(), t.end());
+    }
+}
+
+// Triangles as rotated to their smallest index, the order in the buffer doesn't matter.
+std::vector<std::array<uint32_t, 3>> sortedTriangles(const std::vector<uint32_t> &indices)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        std::array<uint32_t, 3> t{ indices[i], indices[i + 1], indices[i + 2] };
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+TEST(MeshOptimize, VertexCacheStatistics)
+{
+    const uint16_t indices[] = { 0, 1, 2, 2, 1, 3 };
+    const auto stats = gmt::mesh::analyzeVertexCache(indices, 6, 4);
+    EXPECT_EQ(stats.transformedVertices, 4u);
+    EXPECT_FLOAT_EQ(stats.acmr, 2.0f);
+    EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+}
+
+TEST(MeshOptimize, VertexCache)
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    appendGrid(32, 0.0f, &positions, &indices);
+    shuffleTriangles(&indices);
+
+    const auto before = gmt::mesh::analyzeVertexCache(indices.data(), indices.size(), positions.size());
+
+    std::vector<uint32_t> optimized(indices.size());
+    gmt::mesh::optimizeVertexCache(optimized.data(), indices.data(), indices.size(), positions.size());
+    const auto after = gmt::mesh::analyzeVertexCache(optimized.data(), optimized.size(), positions.size());
+
+    EXPECT_EQ(sortedTriangles(optimized), sortedTriangles(indices));
+    EXPECT_LT(after.acmr, 0.8f);
+    EXPECT_LT(after.acmr, before.acmr * 0.5f);
+    EXPECT_LT(after.atvr, 1.6f);
+
+    // In place.
+    gmt::mesh::optimizeVertexCache(indices.data(), indices.data(), indices.size(), positions.size());
+    EXPECT_EQ(indices, optimized);
+}
+
+TEST(MeshOptimize, Overdraw)
+{
+    // The far layer is drawn first, everything seen from +z is shaded twice.
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    appendGrid(8, 0.0f, &positions, &indices);
+    appendGrid(8, 1.0f, &positions, &indices);
+
+    const MeshView before{ positions.data(), positions.size(), indices.data(), indices.size() };
+    const auto overdrawBefore = gmt::mesh::analyzeOverdraw(before);
+    EXPECT_GT(overdrawBefore.overdraw, 1.9f);
+
+    std::vector<uint32_t> optimized(indices.size());
+    gmt::mesh::optimizeVertexCache(optimized.data(), indices.data(), indices.size(), positions.size());
+    gmt::mesh::optimizeOverdraw(optimized.data(),
+        MeshView{ positions.data(), positions.size(), optimized.data(), optimized.size() });
+    EXPECT_EQ(sortedTriangles(optimized), sortedTriangles(indices));
+
+    const MeshView after{ positions.data(), positions.size(), optimized.data(), optimized.size() };
+    const auto overdrawAfter = gmt::mesh::analyzeOverdraw(after);
+    EXPECT_EQ(overdrawAfter.pixelsCovered, overdrawBefore.pixelsCovered);
+    EXPECT_LT(overdrawAfter.overdraw, 1.1f);
+}
+
+TEST(MeshOptimize, VertexFetch)
+{
+    struct Vertex
+    {
+        glm::vec3 position;
+        int id;
+    };
+
+    std::vector<Vertex> vertices;
+    for (int i = 0; i < 6; i++) {
+        vertices.push_back({ glm::vec3{ static_cast<float>(i) }, i });
+    }
+    uint16_t indices[] = { 5, 3, 4, 4, 3, 1 };
+
+    std::vector<Vertex> optimized(vertices.size());
+    const auto count = gmt::mesh::optimizeVertexFetch(optimized.data(), indices, 6, vertices.data(), vertices.size());
+
+    EXPECT_EQ(count, 4u);
+    const uint16_t expectedIndices[] = { 0, 1, 2, 2, 1, 3 };
+    const int expectedIds[] = { 5, 3, 4, 1 };
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(indices[i], expectedIndices[i]);
+    }
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(optimized[i].id, expectedIds[i]);
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gmt/mesh/Quantize.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace mesh_quantize
+{
+
+TEST(MeshQuantize, Half)
+{
+    EXPECT_EQ(gmt::mesh::quantizeHalf(0.0f), 0x0000);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(-0.0f), 0x8000);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(1.0f), 0x3c00);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(-2.0f), 0xc000);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(65504.0f), 0x7bff);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(1e6f), 0x7c00);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(std::numeric_limits<float>::infinity()), 0x7c00);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(std::numeric_limits<float>::quiet_NaN()) & 0x7fff, 0x7e00);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(1e-8f), 0x0000);
+
+    // Rounds to nearest.
+    EXPECT_EQ(gmt::mesh::quantizeHalf(1.0f + 1.4f / 1024.0f), 0x3c01);
+    EXPECT_EQ(gmt::mesh::quantizeHalf(1.0f + 1.6f / 1024.0f), 0x3c02);
+
+    EXPECT_EQ(gmt::mesh::dequantizeHalf(0x3c00), 1.0f);
+    EXPECT_EQ(gmt::mesh::dequantizeHalf(0xc000), -2.0f);
+    EXPECT_EQ(gmt::mesh::dequantizeHalf(0x0001), std::ldexp(1.0f, -24));
+    EXPECT_TRUE(std::isinf(gmt::mesh::dequantizeHalf(0x7c00)));
+
+    std::mt19937 engine{ 7 };
+    std::uniform_real_distribution<float> distribution{ -1000.0f, 1000.0f };
+    std::vector<float> values(1000);
+    for (auto &v : values) {
+        v = distribution(engine);
+    }
+    std::vector<uint16_t> halves(values.size());
+    gmt::mesh::quantizeHalf(halves.data(), values.data(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(halves[i], gmt::mesh::quantizeHalf(values[i]));
+        EXPECT_NEAR(gmt::mesh::dequantizeHalf(halves[i]), values[i], std::abs(values[i]) / 2048.0f);
+    }
+}
+
+TEST(MeshQuantize, Normalized)
+{
+    EXPECT_EQ(gmt::mesh::quantizeSnorm8(1.0f), 127);
+    EXPECT_EQ(gmt::mesh::quantizeSnorm8(-2.0f), -127);
+    EXPECT_EQ(gmt::mesh::quantizeUnorm8(0.5f), 128);
+    EXPECT_EQ(gmt::mesh::quantizeUnorm8(-1.0f), 0);
+    EXPECT_EQ(gmt::mesh::quantizeSnorm16(-0.5f), -16384);
+    EXPECT_EQ(gmt::mesh::quantizeUnorm16(1.0f), 65535);
+
+    const std::vector<float> values{ -1.5f, -1.0f, -0.3f, -0.0f, 0.1f, 0.5f, 0.77f, 1.0f, 3.0f };
+    std::vector<int8_t> snorm8(values.size());
+    std::vector<uint8_t> unorm8(values.size());
+    std::vector<int16_t> snorm16(values.size());
+    std::vector<uint16_t> unorm16(values.size());
+    gmt::mesh::quantizeSnorm8(snorm8.data(), values.data(), values.size());
+    gmt::mesh::quantizeUnorm8(unorm8.data(), values.data(), values.size());
+    gmt::mesh::quantizeSnorm16(snorm16.data(), values.data(), values.size());
+    gmt::mesh::quantizeUnorm16(unorm16.data(), values.data(), values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(snorm8[i], gmt::mesh::quantizeSnorm8(values[i]));
+        EXPECT_EQ(unorm8[i], gmt::mesh::quantizeUnorm8(values[i]));
+        EXPECT_EQ(snorm16[i], gmt::mesh::quantizeSnorm16(values[i]));
+        EXPECT_EQ(unorm16[i], gmt::mesh::quantizeUnorm16(values[i]));
+    }
+}
+
+TEST(MeshQuantize, Packed1010102)
+{
+    const glm::vec4 value{ 1.0f, -1.0f, 0.25f, -1.0f };
+    const auto packed = gmt::mesh::packSnorm1010102(value);
+    EXPECT_EQ(packed & 0x3ffu, 511u);
+    EXPECT_EQ((packed >> 10) & 0x3ffu, 0x3ffu - 510u);
+    EXPECT_EQ(packed >> 30, 3u);
+
+    const auto unpacked = gmt::mesh::unpackSnorm1010102(packed);
+    EXPECT_EQ(unpacked.x, 1.0f);
+    EXPECT_EQ(unpacked.y, -1.0f);
+    EXPECT_NEAR(unpacked.z, 0.25f, 1.0f / 1022.0f);
+    EXPECT_EQ(unpacked.w, -1.0f);
+
+    EXPECT_EQ(gmt::mesh::packUnorm1010102(glm::vec4{ 1.0f, 0.0f, 1.0f, 1.0f }), 0xfff003ffu);
+
+    const glm::vec4 values[] = { value, glm::vec4{ 0.1f, 0.2f, -0.3f, 0.0f }, glm::vec4{ 2.0f } };
+    uint32_t snorm[3];
+    uint32_t unorm[3];
+    gmt::mesh::packSnorm1010102(snorm, values, 3);
+    gmt::mesh::packUnorm1010102(unorm, values, 3);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(snorm[i], gmt::mesh::packSnorm1010102(values[i]));
+        EXPECT_EQ(unorm[i], gmt::mesh::packUnorm1010102(values[i]));
+    }
+}
+
+TEST(MeshQuantize, Octahedral)
+{
+    std::mt19937 engine{ 3 };
+    std::normal_distribution<float> distribution;
+    std::vector<glm::vec3> normals{ { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { 1.0f, 0.0f, 0.0f },
+        { 0.0f, -1.0f, 0.0f } };
+    for (int i = 0; i < 1000; i++) {
+        normals.push_back(glm::normalize(glm::vec3{ distribution(engine), distribution(engine), distribution(engine) }));
+    }
+
+    std::vector<int16_t> encoded(normals.size() * 2);
+    gmt::mesh::encodeOctahedral(encoded.data(), normals.data(), normals.size());
+    for (size_t i = 0; i < normals.size(); i++) {
+        const auto e = gmt::mesh::encodeOctahedral(normals[i]);
+        EXPECT_LE(glm::distance(gmt::mesh::decodeOctahedral(e), normals[i]), 1e-5f);
+
+        // 16 bits keep normals within a hundredth of a degree.
+        const glm::vec2 quantized{ encoded[i * 2] / 32767.0f, encoded[i * 2 + 1] / 32767.0f };
+        EXPECT_EQ(encoded[i * 2], gmt::mesh::quantizeSnorm16(e.x));
+        EXPECT_EQ(encoded[i * 2 + 1], gmt::mesh::quantizeSnorm16(e.y));
+        EXPECT_LT(glm::distance(gmt::mesh::decodeOctahedral(quantized), normals[i]), glm::radians(0.01f));
+    }
+}
+
+}
+
+}
+
+}
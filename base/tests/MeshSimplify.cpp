@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gmt/ThreadPool.h>
+#include <gmt/mesh/Simplify.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace mesh_simplify
+{
+
+namespace
+{
+
+// size x size quads in the z plane, facing +z, with height(x, y) added to z.
+template <typename F>
+void appendGrid(int size, F height, std::vector<glm::vec3> *positions, std::vector<uint32_t> *indices)
+{
+    const auto base = static_cast<uint32_t>(positions->size());
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            const auto fx = static_cast<float>(x);
+            const auto fy = static_cast<float>(y);
+            positions->push_back({ fx, fy, height(fx, fy) });
+        }
+    }
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const auto i = base + static_cast<uint32_t>(y * (size + 1) + x);
+            const auto up = i + static_cast<uint32_t>(size + 1);
+            indices->insert(indices->end(), { i, i + 1, up + 1, i, up + 1, up });
+        }
+    }
+}
+
+void appendFlatGrid(int size, std::vector<glm::vec3> *positions, std::vector<uint32_t> *indices)
+{
+    appendGrid(size, [](float, float) { return 0.0f; }, positions, indices);
+}
+
+float area(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices)
+{
+    float result = 0.0f;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const auto &a = positions[indices[i]];
+        const auto &b = positions[indices[i + 1]];
+        const auto &c = positions[indices[i + 2]];
+        result += glm::cross(b - a, c - a).z * 0.5f;
+    }
+    return result;
+}
+
+}
+
+TEST(MeshSimplify, FlatGrid)
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    appendFlatGrid(16, &positions, &indices);
+
+    float error = -1.0f;
+    const MeshView mesh{ positions.data(), positions.size(), indices.data(), indices.size() };
+    const auto simplified = gmt::mesh::simplify(mesh, 0, 1e-3f, &error);
+
+    // No triangle flips or goes missing, the border keeps its shape.
+    EXPECT_LT(simplified.size(), indices.size() / 4);
+    EXPECT_NEAR(area(positions, simplified), 256.0f, 1e-3f);
+    EXPECT_LE(error, 1e-3f);
+    for (size_t i = 0; i < simplified.size(); i += 3) {
+        const auto &a = positions[simplified[i]];
+        const auto &b = positions[simplified[i + 1]];
+        const auto &c = positions[simplified[i + 2]];
+        EXPECT_GT(glm::cross(b - a, c - a).z, 0.0f);
+    }
+}
+
+TEST(MeshSimplify, TargetCount)
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    appendGrid(16, [](float x, float y) { return std::sin(x * 0.7f) * std::cos(y * 0.5f); }, &positions, &indices);
+
+    const MeshView mesh{ positions.data(), positions.size(), indices.data(), indices.size() };
+    float error = 0.0f;
+    const auto simplified = gmt::mesh::simplify(mesh, indices.size() / 2, std::numeric_limits<float>::max(), &error);
+    EXPECT_LE(simplified.size(), indices.size() / 2);
+    EXPECT_GT(simplified.size(), indices.size() / 4);
+    EXPECT_GT(error, 0.0f);
+
+    // Error bounds stop early, tighter ones sooner.
+    float looseError = 0.0f;
+    float tightError = 0.0f;
+    const auto loose = gmt::mesh::simplify(mesh, 0, 0.1f, &looseError);
+    const auto tight = gmt::mesh::simplify(mesh, 0, 0.01f, &tightError);
+    EXPECT_LE(looseError, 0.1f);
+    EXPECT_LE(tightError, 0.01f);
+    EXPECT_GT(tight.size(), loose.size());
+    EXPECT_LT(tight.size(), indices.size());
+}
+
+TEST(MeshSimplify, Seam)
+{
+    // Two grids side by side, the vertices on x = 8 are duplicated like a UV seam.
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    appendFlatGrid(8, &positions, &indices);
+    const auto rightBase = static_cast<uint32_t>(positions.size());
+    std::vector<glm::vec3> rightPositions;
+    std::vector<uint32_t> rightIndices;
+    appendFlatGrid(8, &rightPositions, &rightIndices);
+    for (auto &p : rightPositions) {
+        positions.push_back(p + glm::vec3{ 8.0f, 0.0f, 0.0f });
+    }
+    for (const auto i : rightIndices) {
+        indices.push_back(rightBase + i);
+    }
+
+    const MeshView mesh{ positions.data(), positions.size(), indices.data(), indices.size() };
+    const auto simplified = gmt::mesh::simplify(mesh, 0, 1e-3f);
+
+    EXPECT_LT(simplified.size(), indices.size() / 4);
+    EXPECT_NEAR(area(positions, simplified), 128.0f, 1e-3f);
+
+    // Triangles never mix the sides, so attributes don't bleed across the seam.
+    float leftArea = 0.0f;
+    for (size_t i = 0; i < simplified.size(); i += 3) {
+        const auto left = simplified[i] < rightBase;
+        EXPECT_EQ(simplified[i + 1] < rightBase, left);
+        EXPECT_EQ(simplified[i + 2] < rightBase, left);
+        if (left) {
+            leftArea += area(positions, { simplified[i], simplified[i + 1], simplified[i + 2] });
+        }
+    }
+    EXPECT_NEAR(leftArea, 64.0f, 1e-3f);
+}
+
+TEST(MeshSimplify, LodChain)
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint16_t> indices;
+    {
+        std::vector<uint32_t> indices32;
+        appendGrid(16, [](float x, float y) { return std::sin(x * 0.4f + y * 0.3f); }, &positions, &indices32);
+        indices.assign(indices32.begin(), indices32.end());
+    }
+
+    const MeshView mesh{ positions.data(), positions.size(), indices.data(), indices.size() };
+    const auto chain = gmt::mesh::buildLodChain(mesh);
+    ASSERT_EQ(chain.size(), 4u);
+    EXPECT_EQ(chain[0].indices.size(), indices.size());
+    EXPECT_EQ(chain[0].error, 0.0f);
+    for (size_t i = 1; i < chain.size(); i++) {
+        EXPECT_LE(chain[i].indices.size(), chain[i - 1].indices.size() / 2 + 2);
+        EXPECT_GE(chain[i].error, chain[i - 1].error);
+    }
+
+    EXPECT_EQ(gmt::mesh::selectLod(chain, 1e9f), 0u);
+    EXPECT_EQ(gmt::mesh::selectLod(chain, 0.0f), 3u);
+    const auto pixelsPerUnit = 1.0f / (chain[2].error + 1e-6f);
+    EXPECT_EQ(gmt::mesh::selectLod(chain, pixelsPerUnit), 2u);
+}
+
+TEST(MeshSimplify, ParallelChains)
+{
+    std::vector<std::vector<glm::vec3>> positions(6);
+    std::vector<std::vector<uint32_t>> indices(6);
+    std::vector<MeshView> meshes;
+    for (size_t i = 0; i < positions.size(); i++) {
+        const auto frequency = 0.2f + 0.1f * static_cast<float>(i);
+        appendGrid(12, [=](float x, float y) { return std::sin(x * frequency) * y * 0.1f; }, &positions[i],
+            &indices[i]);
+        meshes.emplace_back(positions[i].data(), positions[i].size(), indices[i].data(), indices[i].size());
+    }
+
+    ThreadPool pool{ 3 };
+    const auto parallel = gmt::mesh::buildLodChains(meshes, {}, &pool);
+    const auto serial = gmt::mesh::buildLodChains(meshes);
+    ASSERT_EQ(parallel.size(), serial.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        ASSERT_EQ(parallel[i].size(), serial[i].size());
+        for (size_t l = 0; l < serial[i].size(); l++) {
+            EXPECT_EQ(parallel[i][l].indices, serial[i][l].indices);
+            EXPECT_EQ(parallel[i][l].error, serial[i][l].error);
+        }
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <gmt/ThreadPool.h>
+#include <gmt/mesh/Skinning.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace mesh_skinning
+{
+
+namespace
+{
+
+struct Vertex
+{
+    glm::vec3 position;
+    glm::vec2 texcoords;
+    glm::vec3 normal;
+};
+
+struct Mesh
+{
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::u16vec4> bones;
+    std::vector<glm::vec4> weights;
+
+    mesh::SkinInput input() const
+    {
+        return { positions.data(), normals.data(), bones.data(), weights.data(), positions.size() };
+    }
+};
+
+Mesh makeMesh(size_t count, uint16_t bonesCount)
+{
+    Mesh mesh;
+    for (size_t i = 0; i < count; i++) {
+        const auto f = static_cast<float>(i);
+        mesh.positions.push_back({ std::sin(f), f * 0.01f, std::cos(f) });
+        mesh.normals.push_back(glm::normalize(glm::vec3{ std::cos(f), 0.5f, std::sin(f) }));
+        mesh.bones.push_back({ i % bonesCount, (i + 1) % bonesCount, (i * 3) % bonesCount, (i * 7) % bonesCount });
+        mesh.weights.push_back({ 0.4f, 0.3f, 0.2f, 0.1f });
+    }
+    return mesh;
+}
+
+glm::quat boneRotation(size_t bone)
+{
+    return glm::angleAxis(static_cast<float>(bone) * 0.7f, glm::normalize(glm::vec3{ 1.0f, static_cast<float>(bone), 2.0f }));
+}
+
+glm::vec3 boneTranslation(size_t bone)
+{
+    return { static_cast<float>(bone), -1.0f, 0.5f * static_cast<float>(bone) };
+}
+
+void expectNear(const glm::vec3 &actual, const glm::vec3 &expected, float epsilon = 1e-4f)
+{
+    EXPECT_NEAR(actual.x, expected.x, epsilon);
+    EXPECT_NEAR(actual.y, expected.y, epsilon);
+    EXPECT_NEAR(actual.z, expected.z, epsilon);
+}
+
+}
+
+TEST(MeshSkinning, Linear)
+{
+    const auto mesh = makeMesh(200, 5);
+    mesh::MatrixPalette palette;
+    palette.resize(5);
+    std::vector<glm::mat4> matrices;
+    for (size_t bone = 0; bone < 5; bone++) {
+        matrices.push_back(glm::translate(glm::mat4{ 1.0f }, boneTranslation(bone)) * glm::mat4_cast(boneRotation(bone)));
+        palette.set(bone, matrices.back());
+    }
+
+    // Interleaved destination, like a streaming vertex buffer.
+    std::vector<Vertex> vertices(mesh.positions.size());
+    mesh::skinLinear(mesh.input(), palette, { vertices.data(), &Vertex::position, &Vertex::normal });
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        glm::mat4 blended{ 0.0f };
+        for (int k = 0; k < 4; k++) {
+            blended += matrices[mesh.bones[i][k]] * mesh.weights[i][k];
+        }
+        expectNear(vertices[i].position, glm::vec3{ blended * glm::vec4{ mesh.positions[i], 1.0f } });
+        expectNear(vertices[i].normal, glm::normalize(glm::vec3{ blended * glm::vec4{ mesh.normals[i], 0.0f } }));
+    }
+}
+
+TEST(MeshSkinning, DualQuaternionRigid)
+{
+    // With a single influence dual quaternion skinning is the bone's rigid transform.
+    auto mesh = makeMesh(100, 4);
+    for (auto &w : mesh.weights) {
+        w = { 1.0f, 0.0f, 0.0f, 0.0f };
+    }
+
+    mesh::DualQuaternionPalette palette;
+    palette.resize(4);
+    for (size_t bone = 0; bone < 4; bone++) {
+        palette.set(bone, boneRotation(bone), boneTranslation(bone));
+    }
+
+    std::vector<glm::vec3> positions(mesh.positions.size());
+    std::vector<glm::vec3> normals(mesh.positions.size());
+    mesh::skinDualQuaternion(mesh.input(), palette, { positions.data(), normals.data() });
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        const auto bone = mesh.bones[i].x;
+        expectNear(positions[i], boneRotation(bone) * mesh.positions[i] + boneTranslation(bone));
+        expectNear(normals[i], boneRotation(bone) * mesh.normals[i]);
+    }
+}
+
+TEST(MeshSkinning, DualQuaternionAntipodal)
+{
+    // q and -q describe the same bone, the blend must not collapse.
+    auto mesh = makeMesh(1, 2);
+    mesh.bones[0] = { 0, 1, 0, 0 };
+    mesh.weights[0] = { 0.5f, 0.5f, 0.0f, 0.0f };
+
+    const auto rotation = glm::angleAxis(0.5f, glm::vec3{ 0.0f, 1.0f, 0.0f });
+    const glm::vec3 translation{ 1.0f, 2.0f, 3.0f };
+    mesh::DualQuaternionPalette palette;
+    palette.resize(2);
+    palette.set(0, rotation, translation);
+    palette.set(1, -rotation, translation);
+
+    glm::vec3 position;
+    mesh::skinDualQuaternion(mesh.input(), palette, { &position, nullptr });
+    expectNear(position, rotation * mesh.positions[0] + translation);
+}
+
+TEST(MeshSkinning, DualQuaternionZeroWeights)
+{
+    // No influence, the vertex stays in place rather than turning into NaN.
+    auto mesh = makeMesh(1, 2);
+    mesh.bones[0] = { 0, 1, 0, 0 };
+    mesh.weights[0] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    mesh::DualQuaternionPalette palette;
+    palette.resize(2);
+    palette.set(0, boneRotation(0), boneTranslation(0));
+    palette.set(1, boneRotation(1), boneTranslation(1));
+
+    glm::vec3 position;
+    glm::vec3 normal;
+    mesh::skinDualQuaternion(mesh.input(), palette, { &position, &normal });
+    expectNear(position, mesh.positions[0]);
+    expectNear(normal, mesh.normals[0]);
+}
+
+TEST(MeshSkinning, Parallel)
+{
+    const std::vector<Mesh> meshes = { makeMesh(40000, 30), makeMesh(1000, 30), makeMesh(0, 30) };
+    mesh::MatrixPalette matrices;
+    mesh::DualQuaternionPalette dualQuaternions;
+    matrices.resize(30);
+    dualQuaternions.resize(30);
+    for (size_t bone = 0; bone < 30; bone++) {
+        matrices.set(bone, glm::translate(glm::mat4{ 1.0f }, boneTranslation(bone)) * glm::mat4_cast(boneRotation(bone)));
+        dualQuaternions.set(bone, boneRotation(bone), boneTranslation(bone));
+    }
+
+    for (auto *pool : { static_cast<ThreadPool*>(nullptr), &ThreadPool::shared() }) {
+        std::vector<std::vector<glm::vec3>> linear;
+        std::vector<std::vector<glm::vec3>> dual;
+        std::vector<mesh::LinearSkinJob> linearJobs;
+        std::vector<mesh::DualQuaternionSkinJob> dualJobs;
+        for (const auto &mesh : meshes) {
+            linear.emplace_back(mesh.positions.size());
+            dual.emplace_back(mesh.positions.size());
+        }
+        for (size_t i = 0; i < meshes.size(); i++) {
+            linearJobs.push_back({ meshes[i].input(), &matrices, { linear[i].data(), nullptr } });
+            dualJobs.push_back({ meshes[i].input(), &dualQuaternions, { dual[i].data(), nullptr } });
+        }
+        mesh::skin(linearJobs.data(), linearJobs.size(), pool);
+        mesh::skin(dualJobs.data(), dualJobs.size(), pool);
+
+        for (size_t i = 0; i < meshes.size(); i++) {
+            std::vector<glm::vec3> expected(meshes[i].positions.size());
+            mesh::skinLinear(meshes[i].input(), matrices, { expected.data(), nullptr });
+            ASSERT_EQ(linear[i], expected);
+            mesh::skinDualQuaternion(meshes[i].input(), dualQuaternions, { expected.data(), nullptr });
+            ASSERT_EQ(dual[i], expected);
+        }
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <gmt/mesh/Meshlets.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace meshlets
+{
+
+namespace
+{
+
+// size x size quads in the z = 0 plane, facing +z.
+void appendGrid(int size, std::vector<glm::vec3> *positions, std::vector<uint32_t> *indices)
+{
+    const auto base = static_cast<uint32_t>(positions->size());
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            positions->push_back({ static_cast<float>(x), static_cast<float>(y), 0.0f });
+        }
+    }
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const auto i = base + static_cast<uint32_t>(y * (size + 1) + x);
+            const auto up = i + static_cast<uint32_t>(size + 1);
+            indices->insert(indices->end(), { i, i + 1, up + 1, i, up + 1, up });
+        }
+    }
+}
+
+std::vector<std::array<uint32_t, 3>> sortedTriangles(const std::vector<uint32_t> &indices)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        std::array<uint32_t, 3> t{ indices[i], indices[i + 1], indices[i + 2] };
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// Whether every triangle of indices with all its vertices passing predicate is in kept.
+template <typename P>
+bool keepsAll(const std::vector<uint32_t> &kept, const std::vector<glm::vec3> &positions,
+    const std::vector<uint32_t> &indices, P predicate)
+{
+    const auto keptTriangles = sortedTriangles(kept);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const auto selected = std::all_of(indices.begin() + i, indices.begin() + i + 3,
+            [&](uint32_t index) { return predicate(positions[index]); });
+        const auto t = sortedTriangles({ indices[i], indices[i + 1], indices[i + 2] })[0];
+        if (selected && !std::binary_search(keptTriangles.begin(), keptTriangles.end(), t)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Grid
+{
+    Grid(int size)
+    {
+        appendGrid(size, &positions, &indices);
+    }
+
+    MeshView view() const { return { positions.data(), positions.size(), indices.data(), indices.size() }; }
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+};
+
+}
+
+TEST(Meshlets, Build)
+{
+    const Grid grid{ 32 };
+    const auto meshlets = gmt::mesh::buildMeshlets(grid.view());
+
+    ASSERT_EQ(meshlets.bounds.size(), meshlets.size());
+    EXPECT_LT(meshlets.size(), 2048u / 124u * 2u);
+    for (size_t m = 0; m < meshlets.size(); m++) {
+        const auto &meshlet = meshlets.meshlets[m];
+        const auto &bounds = meshlets.bounds[m];
+        EXPECT_LE(meshlet.verticesCount, gmt::mesh::maxMeshletVertices);
+        EXPECT_LE(meshlet.trianglesCount, gmt::mesh::maxMeshletTriangles);
+
+        for (uint32_t v = 0; v < meshlet.verticesCount; v++) {
+            const auto &p = grid.positions[meshlets.vertices[meshlet.verticesOffset + v]];
+            EXPECT_LE(glm::distance(p, bounds.sphere.center), bounds.sphere.radius + 1e-4f);
+        }
+
+        // Flat, the cone is the normal and culls the whole back half space.
+        EXPECT_NEAR(bounds.coneAxis.z, 1.0f, 1e-5f);
+        EXPECT_NEAR(bounds.coneCutoff, 0.0f, 1e-3f);
+    }
+
+    // Culling nothing gives back every triangle.
+    gmt::mesh::ClusterCullView view;
+    view.eye = glm::vec4{ 16.0f, 16.0f, 10.0f, 1.0f };
+    std::vector<uint32_t> indices;
+    EXPECT_EQ(gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, view, &indices), meshlets.size());
+    EXPECT_EQ(sortedTriangles(indices), sortedTriangles(grid.indices));
+}
+
+TEST(Meshlets, SmallLimits)
+{
+    const Grid grid{ 8 };
+    const auto meshlets = gmt::mesh::buildMeshlets(grid.view(), 8, 6);
+    for (const auto &meshlet : meshlets.meshlets) {
+        EXPECT_LE(meshlet.verticesCount, 8u);
+        EXPECT_LE(meshlet.trianglesCount, 6u);
+    }
+
+    gmt::mesh::ClusterCullView view;
+    view.eye = glm::vec4{ 0.0f, 0.0f, 1.0f, 0.0f };
+    std::vector<uint16_t> indices;
+    gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, view, &indices);
+    EXPECT_EQ(indices.size(), grid.indices.size());
+}
+
+TEST(Meshlets, ConeCulling)
+{
+    const Grid grid{ 16 };
+    const auto meshlets = gmt::mesh::buildMeshlets(grid.view());
+
+    gmt::mesh::ClusterCullView view;
+    std::vector<uint32_t> indices;
+
+    view.eye = glm::vec4{ 8.0f, 8.0f, -5.0f, 1.0f };
+    EXPECT_EQ(gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, view, &indices), 0u);
+
+    view.eye = glm::vec4{ 0.0f, 0.0f, -1.0f, 0.0f };
+    EXPECT_EQ(gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, view, &indices), 0u);
+
+    // Turned over by the model matrix, seen from below.
+    const auto flip = glm::rotate(glm::mat4{ 1.0f }, glm::radians(180.0f), glm::vec3{ 1.0f, 0.0f, 0.0f });
+    view.eye = glm::vec4{ 8.0f, -8.0f, -5.0f, 1.0f };
+    EXPECT_EQ(gmt::mesh::cullMeshlets(meshlets, flip, view, &indices), meshlets.size());
+    EXPECT_EQ(indices.size(), grid.indices.size());
+}
+
+TEST(Meshlets, FrustumCulling)
+{
+    const Grid grid{ 32 };
+    const auto meshlets = gmt::mesh::buildMeshlets(grid.view());
+
+    // Keeps x >= 24.
+    gmt::mesh::ClusterCullView view;
+    view.eye = glm::vec4{ 16.0f, 16.0f, 10.0f, 1.0f };
+    view.planes[0] = Plane{ { 24.0f, 0.0f, 0.0f }, { 24.0f, 1.0f, 0.0f }, { 24.0f, 0.0f, 1.0f } };
+
+    std::vector<uint32_t> indices;
+    const auto count = gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, view, &indices);
+    EXPECT_GT(count, 0u);
+    EXPECT_LT(count, meshlets.size() / 2);
+
+    EXPECT_TRUE(keepsAll(indices, grid.positions, grid.indices, [](const glm::vec3 &p) { return p.x >= 24.0f; }));
+}
+
+TEST(Meshlets, DepthPyramid)
+{
+    const float depth[] = {
+        0.1f, 0.2f, 0.3f, 0.4f, 0.5f,
+        0.6f, 0.7f, 0.8f, 0.9f, 1.0f,
+        0.3f, 0.3f, 0.3f, 0.3f, 0.3f,
+    };
+    const gmt::mesh::DepthPyramid pyramid{ depth, 5, 3 };
+    ASSERT_EQ(pyramid.levelsCount(), 4u);
+    EXPECT_EQ(pyramid.getWidth(1), 3u);
+    EXPECT_EQ(pyramid.getHeight(1), 2u);
+    EXPECT_EQ(pyramid.getDepth(1, 0, 0), 0.7f);
+    EXPECT_EQ(pyramid.getDepth(1, 2, 0), 1.0f);
+    EXPECT_EQ(pyramid.getDepth(1, 1, 1), 0.3f);
+    EXPECT_EQ(pyramid.getDepth(3, 0, 0), 1.0f);
+
+    // A single texel of the bottom left corner.
+    EXPECT_TRUE(pyramid.visible({ 0.0f, 0.0f }, { 0.1f, 0.1f }, 0.05f));
+    EXPECT_FALSE(pyramid.visible({ 0.0f, 0.0f }, { 0.1f, 0.1f }, 0.15f));
+
+    // The whole buffer.
+    EXPECT_TRUE(pyramid.visible({ 0.0f, 0.0f }, { 1.0f, 1.0f }, 0.99f));
+
+    // Source texels 1 to 3 of the bottom row, read at level 1 where the width of 5 is odd.
+    const float row[] = { 0.1f, 0.9f, 0.1f, 0.1f, 0.1f };
+    const gmt::mesh::DepthPyramid odd{ row, 5, 1 };
+    EXPECT_TRUE(odd.visible({ 0.35f, 0.0f }, { 0.6f, 1.0f }, 0.5f));
+
+    const float reversedDepth[] = { 0.5f, 0.2f, 0.9f, 0.4f };
+    const gmt::mesh::DepthPyramid reversed{ reversedDepth, 2, 2, true };
+    EXPECT_EQ(reversed.getDepth(1, 0, 0), 0.2f);
+    EXPECT_TRUE(reversed.visible({ 0.0f, 0.0f }, { 1.0f, 1.0f }, 0.3f));
+    EXPECT_FALSE(reversed.visible({ 0.0f, 0.0f }, { 1.0f, 1.0f }, 0.1f));
+}
+
+TEST(Meshlets, OcclusionCulling)
+{
+    const Grid grid{ 16 };
+    const auto meshlets = gmt::mesh::buildMeshlets(grid.view());
+
+    // Looking down at the grid, 10 units away, depth range 1 to 21.
+    const auto view = glm::lookAt(glm::vec3{ 8.0f, 8.0f, 10.0f }, glm::vec3{ 8.0f, 8.0f, 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+    const auto proj = glm::ortho(-8.0f, 8.0f, -8.0f, 8.0f, 1.0f, 21.0f);
+
+    gmt::mesh::ClusterCullView cullView;
+    cullView.eye = glm::vec4{ 0.0f, 0.0f, 1.0f, 0.0f };
+    cullView.viewProj = proj * view;
+
+    // The grid is at window depth 0.45, an occluder covers the left half at 0.25.
+    std::vector<float> depth(64 * 64, 1.0f);
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 32; x++) {
+            depth[y * 64 + x] = 0.25f;
+        }
+    }
+    const gmt::mesh::DepthPyramid pyramid{ depth.data(), 64, 64 };
+    cullView.depthPyramid = &pyramid;
+
+    std::vector<uint32_t> indices;
+    const auto count = gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, cullView, &indices);
+    EXPECT_GT(count, 0u);
+    EXPECT_LT(count, meshlets.size());
+    EXPECT_TRUE(keepsAll(indices, grid.positions, grid.indices, [](const glm::vec3 &p) { return p.x >= 8.0f; }));
+
+    // Cleared depth occludes nothing.
+    std::fill(depth.begin(), depth.end(), 1.0f);
+    const gmt::mesh::DepthPyramid cleared{ depth.data(), 64, 64 };
+    cullView.depthPyramid = &cleared;
+    EXPECT_EQ(gmt::mesh::cullMeshlets(meshlets, glm::mat4{ 1.0f }, cullView, &indices), meshlets.size());
+}
+
+}
+
+}
+
+}
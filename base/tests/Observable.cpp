@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <memory>
+#include <vector>
+
 #include <gmt/Observable.h>
 
 namespace gmt
@@ -38,6 +41,12 @@ public:
     {
         notify([](auto x){ x->bar(); });
     }
+
+    template <typename F>
+    void each(const F &f)
+    {
+        notify(f);
+    }
 };
 
 }
@@ -125,6 +134,87 @@ TEST(Observable, RemoveObserver)
     a.foo();
 }
 
+TEST(Observable, RemoveObserverAddedTwice)
+{
+    A a;
+    Listener listener;
+    a.addObserver(&listener);
+    a.addObserver(&listener);
+
+    EXPECT_CALL(listener, foo()).Times(2);
+
+    a.foo();
+    a.removeObserver(&listener);
+    EXPECT_EQ(a.getObserversCount(), 0u);
+
+    EXPECT_CALL(listener, foo()).Times(0);
+
+    a.foo();
+}
+
+TEST(Observable, RemoveByToken)
+{
+    A a;
+    Listener first;
+    Listener second;
+    Listener third;
+    const auto firstToken = a.addObserver(&first);
+    a.addObserver(&second);
+    const auto thirdToken = a.addObserver(&third);
+
+    // Removing the first one moves the third one, its token stays valid.
+    a.removeObserver(firstToken);
+    a.removeObserver(firstToken);
+    EXPECT_EQ(a.getObserversCount(), 2u);
+
+    EXPECT_CALL(first, foo()).Times(0);
+    EXPECT_CALL(second, foo()).Times(1);
+    EXPECT_CALL(third, foo()).Times(0);
+
+    a.removeObserver(thirdToken);
+    a.foo();
+    EXPECT_EQ(a.getObserversCount(), 1u);
+}
+
+TEST(Observable, RemoveWhileNotifying)
+{
+    A a;
+    std::vector<std::unique_ptr<Listener>> listeners;
+    std::vector<ObserverToken> tokens;
+    for (int i = 0; i < 100; i++) {
+        listeners.push_back(std::make_unique<Listener>());
+        tokens.push_back(a.addObserver(listeners.back().get()));
+    }
+
+    // Every notified observer removes all the others.
+    int calls = 0;
+    a.each([&](Listener *) {
+        calls += 1;
+        for (const auto token : tokens) {
+            a.removeObserver(token);
+        }
+    });
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(a.getObserversCount(), 0u);
+}
+
+TEST(Observable, CompactDestroyed)
+{
+    A a;
+    Listener alive;
+    a.addObserver(&alive);
+    for (int i = 0; i < 10; i++) {
+        Listener destroyed;
+        a.addObserver(&destroyed);
+    }
+    EXPECT_EQ(a.getObserversCount(), 11u);
+
+    EXPECT_CALL(alive, foo()).Times(1);
+    a.foo();
+    EXPECT_EQ(a.getObserversCount(), 1u);
+}
+
 }
 
 }
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gmt/Random.h>
 #include <gmt/utils.h>
 
 using namespace ::testing;
@@ -17,4 +22,125 @@ TEST(Random, RandomDistribution2) {
     for (int i = 0; i < 32; i++) {
         EXPECT_EQ(t(), 1);
     }
-}
\ No newline at end of file
+}
+
+TEST(RandomEngine, Deterministic) {
+    gmt::RandomEngine a{ 42 };
+    gmt::RandomEngine b{ 42 };
+    gmt::RandomEngine c{ 43 };
+    bool differs = false;
+    for (int i = 0; i < 100; i++) {
+        const auto value = a();
+        EXPECT_EQ(value, b());
+        differs = differs || value != c();
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST(RandomEngine, Jump) {
+    // Jumped copies draw other values than the original.
+    gmt::RandomEngine a{ 7 };
+    auto b = a;
+    b.jump();
+    std::vector<uint64_t> first;
+    std::vector<uint64_t> second;
+    for (int i = 0; i < 256; i++) {
+        first.push_back(a());
+        second.push_back(b());
+    }
+    std::sort(first.begin(), first.end());
+    for (const auto value : second) {
+        EXPECT_FALSE(std::binary_search(first.begin(), first.end(), value));
+    }
+}
+
+TEST(RandomEngine, LanesDistinct) {
+    // Every lane runs its own stream, the outputs of one step differ pairwise.
+    gmt::RandomEngine engine{ 3 };
+    for (int step = 0; step < 64; step++) {
+        std::vector<uint64_t> values;
+        for (size_t i = 0; i < gmt::RandomEngine::lanes; i++) {
+            values.push_back(engine());
+        }
+        std::sort(values.begin(), values.end());
+        EXPECT_EQ(std::adjacent_find(values.begin(), values.end()), values.end());
+    }
+
+    std::vector<float> filled(64 * gmt::RandomEngine::lanes);
+    engine.fill(filled.data(), filled.size(), 0.0f, 1.0f);
+    for (size_t i = 0; i < filled.size(); i += gmt::RandomEngine::lanes) {
+        std::vector<float> values(filled.begin() + i, filled.begin() + i + gmt::RandomEngine::lanes);
+        std::sort(values.begin(), values.end());
+        EXPECT_EQ(std::adjacent_find(values.begin(), values.end()), values.end());
+    }
+}
+
+TEST(RandomEngine, Uniform) {
+    gmt::RandomEngine engine{ 1 };
+    int counts[5] = {};
+    double sum = 0.0;
+    for (int i = 0; i < 10000; i++) {
+        const auto value = engine.uniform(1, 5);
+        ASSERT_THAT(value, AllOf(Ge(1), Le(5)));
+        counts[value - 1] += 1;
+
+        const auto real = engine.uniform(-1.0f, 1.0f);
+        ASSERT_THAT(real, AllOf(Ge(-1.0f), Le(1.0f)));
+        sum += real;
+    }
+    for (const auto count : counts) {
+        EXPECT_NEAR(count, 2000, 200);
+    }
+    EXPECT_NEAR(sum / 10000, 0.0, 0.05);
+
+    EXPECT_EQ(engine.uniform(3, 3), 3);
+    EXPECT_THAT(engine.uniform(INT32_MIN, INT32_MAX), AllOf(Ge(INT32_MIN), Le(INT32_MAX)));
+    EXPECT_THAT(engine.uniform(int64_t{ -5 }, int64_t{ 5 }), AllOf(Ge(-5), Le(5)));
+}
+
+TEST(RandomEngine, Fill) {
+    gmt::RandomEngine engine{ 1 };
+
+    std::vector<float> floats(1000);
+    engine.fill(floats.data(), floats.size(), 2.0f, 3.0f);
+    EXPECT_THAT(floats, Each(AllOf(Ge(2.0f), Le(3.0f))));
+    EXPECT_NE(floats.front(), floats.back());
+
+    std::vector<int32_t> ints(1001);
+    engine.fill(ints.data(), ints.size(), -3, 3);
+    EXPECT_THAT(ints, Each(AllOf(Ge(-3), Le(3))));
+    EXPECT_THAT(ints, Contains(-3));
+    EXPECT_THAT(ints, Contains(3));
+
+    std::vector<glm::vec2> points(100);
+    engine.fill(points.data(), points.size(), glm::vec2{ 0.0f, 10.0f }, glm::vec2{ 1.0f, 20.0f });
+    for (const auto &point : points) {
+        EXPECT_THAT(point.x, AllOf(Ge(0.0f), Le(1.0f)));
+        EXPECT_THAT(point.y, AllOf(Ge(10.0f), Le(20.0f)));
+    }
+}
+
+TEST(RandomEngine, Threads) {
+    // Every thread draws from its own engine.
+    gmt::setRandomSeed(5);
+    const auto first = gmt::utils::random(0, 1000000);
+    gmt::setRandomSeed(5);
+    EXPECT_EQ(gmt::utils::random(0, 1000000), first);
+
+    auto distribution = gmt::utils::randomDistribution(0.0f, 1.0f);
+    std::vector<std::thread> threads;
+    std::vector<float> sums(4, 0.0f);
+    for (size_t i = 0; i < sums.size(); i++) {
+        threads.emplace_back([&distribution, &sums, i]() {
+            for (int j = 0; j < 1000; j++) {
+                sums[i] += distribution();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const auto sum : sums) {
+        EXPECT_NEAR(sum, 500.0f, 50.0f);
+    }
+}
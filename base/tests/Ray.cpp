@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <gmt/math/Plane.h>
+#include <gmt/math/Ray.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace ray
+{
+
+namespace
+{
+
+const glm::vec3 p0{ 0.0f, 0.0f, 0.0f };
+const glm::vec3 p1{ 1.0f, 0.0f, 0.0f };
+const glm::vec3 p2{ 0.0f, 1.0f, 0.0f };
+
+}
+
+TEST(Ray, TriangleHit)
+{
+    RayHit hit;
+    const auto r = Ray{ { 0.25f, 0.25f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+    EXPECT_TRUE(gmt::ray::intersectsTriangle(r, p0, p1, p2, &hit));
+    EXPECT_NEAR(hit.t, 1.0f, 0.00001f);
+    EXPECT_NEAR(hit.u, 0.25f, 0.00001f);
+    EXPECT_NEAR(hit.v, 0.25f, 0.00001f);
+}
+
+TEST(Ray, TriangleMiss)
+{
+    RayHit hit;
+    EXPECT_FALSE(gmt::ray::intersectsTriangle(
+        Ray{ { 0.75f, 0.75f, 1.0f }, { 0.0f, 0.0f, -1.0f } }, p0, p1, p2, &hit));
+    EXPECT_FALSE(gmt::ray::intersectsTriangle(
+        Ray{ { 0.25f, 0.25f, 1.0f }, { 0.0f, 0.0f, 1.0f } }, p0, p1, p2, &hit));
+    EXPECT_FALSE(gmt::ray::intersectsTriangle(
+        Ray{ { 0.25f, 0.25f, 1.0f }, { 0.0f, 0.0f, -1.0f } }, p0, p1, p2, &hit, 0.5f));
+}
+
+TEST(Ray, TriangleCulling)
+{
+    RayHit hit;
+    // Plane{ p0, p1, p2 }.normal() is +z, so rays going down hit the front face.
+    const auto down = Ray{ { 0.25f, 0.25f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+    const auto up = Ray{ { 0.25f, 0.25f, -1.0f }, { 0.0f, 0.0f, 1.0f } };
+    EXPECT_TRUE(gmt::ray::intersectsTriangle(down, p0, p1, p2, &hit, 10.0f, gmt::ray::Culling::BackFaces));
+    EXPECT_FALSE(gmt::ray::intersectsTriangle(up, p0, p1, p2, &hit, 10.0f, gmt::ray::Culling::BackFaces));
+    EXPECT_TRUE(gmt::ray::intersectsTriangle(up, p0, p1, p2, &hit));
+}
+
+TEST(Ray, ConsistentWithPlane)
+{
+    const glm::vec3 a{ 1.0f, 2.0f, 3.0f };
+    const glm::vec3 b{ 4.0f, 1.0f, 2.0f };
+    const glm::vec3 c{ 2.0f, 5.0f, 0.0f };
+    const glm::vec3 s{ 0.0f, 0.0f, 0.0f };
+    const glm::vec3 t{ 6.0f, 6.0f, 4.0f };
+
+    gmt::Plane plane{ a, b, c };
+    const auto expected = plane.intersect(s, t);
+
+    RayHit hit;
+    ASSERT_TRUE(gmt::ray::intersectsTriangle(Ray::fromPoints(s, t), a, b, c, &hit));
+    const auto actual = Ray::fromPoints(s, t).at(hit.t);
+    EXPECT_NEAR(actual.x, expected.x, 0.0001f);
+    EXPECT_NEAR(actual.y, expected.y, 0.0001f);
+    EXPECT_NEAR(actual.z, expected.z, 0.0001f);
+}
+
+TEST(Ray, Box)
+{
+    float tNear;
+    const glm::vec3 min{ -1.0f };
+    const glm::vec3 max{ 1.0f };
+    EXPECT_TRUE(gmt::ray::intersectsBox(Ray{ { -3.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, min, max, &tNear));
+    EXPECT_NEAR(tNear, 2.0f, 0.00001f);
+
+    EXPECT_TRUE(gmt::ray::intersectsBox(Ray{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, min, max, &tNear));
+    EXPECT_NEAR(tNear, 0.0f, 0.00001f);
+
+    EXPECT_FALSE(gmt::ray::intersectsBox(Ray{ { -3.0f, 2.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, min, max, &tNear));
+    EXPECT_FALSE(gmt::ray::intersectsBox(Ray{ { -3.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f } }, min, max, &tNear));
+    EXPECT_FALSE(gmt::ray::intersectsBox(Ray{ { -3.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, min, max, &tNear, 1.0f));
+}
+
+TEST(Ray, RayPacketMatchesScalar)
+{
+    RayPacket<8> rays;
+    for (int i = 0; i < 8; i++) {
+        rays.set(i, Ray{ { -0.25f + 0.2f * i, 0.3f, 2.0f }, { 0.05f * i, -0.1f, -1.0f } });
+    }
+
+    HitPacket<8> hits;
+    hits.reset();
+    const auto mask = gmt::ray::intersectsTriangle(rays, p0, p1, p2, &hits);
+
+    for (int i = 0; i < 8; i++) {
+        RayHit hit;
+        const auto expected = gmt::ray::intersectsTriangle(rays.get(i), p0, p1, p2, &hit);
+        EXPECT_EQ(expected, (mask & (1 << i)) != 0);
+        if (expected) {
+            EXPECT_NEAR(hits.t[i], hit.t, 0.00001f);
+            EXPECT_NEAR(hits.u[i], hit.u, 0.00001f);
+            EXPECT_NEAR(hits.v[i], hit.v, 0.00001f);
+        }
+    }
+}
+
+TEST(Ray, TrianglePacketClosest)
+{
+    TrianglePacket<4> triangles;
+    for (int i = 0; i < 3; i++) {
+        const glm::vec3 offset{ 0.0f, 0.0f, -static_cast<float>(i) };
+        triangles.set(i, p0 + offset, p1 + offset, p2 + offset);
+    }
+    triangles.clear(3);
+
+    HitPacket<4> hits;
+    hits.reset();
+    const auto mask = gmt::ray::intersectsTriangle(
+        Ray{ { 0.25f, 0.25f, 1.0f }, { 0.0f, 0.0f, -1.0f } }, triangles, &hits);
+
+    EXPECT_EQ(mask, 0b0111);
+    EXPECT_EQ(gmt::ray::closestLane(mask, hits), 0);
+    EXPECT_NEAR(hits.t[2], 3.0f, 0.00001f);
+}
+
+TEST(Ray, BoxPacket)
+{
+    BoxPacket<4> boxes;
+    boxes.set(0, glm::vec3{ -1.0f }, glm::vec3{ 1.0f });
+    boxes.set(1, glm::vec3{ 2.0f, -1.0f, -1.0f }, glm::vec3{ 3.0f, 1.0f, 1.0f });
+    boxes.set(2, glm::vec3{ 2.0f, 2.0f, 2.0f }, glm::vec3{ 3.0f, 3.0f, 3.0f });
+    boxes.clear(3);
+
+    float tNear[4];
+    const auto mask = gmt::ray::intersectsBox(Ray{ { -3.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, boxes, tNear);
+    EXPECT_EQ(mask, 0b0011);
+    EXPECT_NEAR(tNear[0], 2.0f, 0.00001f);
+    EXPECT_NEAR(tNear[1], 5.0f, 0.00001f);
+}
+
+}
+
+}
+
+}
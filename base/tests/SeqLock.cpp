@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <gmt/SeqLock.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace seq_lock
+{
+
+namespace
+{
+
+struct Value
+{
+    uint64_t a;
+    uint64_t b;
+    float c[5];
+};
+
+}
+
+TEST(SeqLock, StoreLoad)
+{
+    SeqLock<Value> lock;
+    EXPECT_EQ(lock.load().a, 0u);
+
+    lock.store(Value{ 1, 2, { 3.0f, 4.0f, 5.0f, 6.0f, 7.0f } });
+    const auto value = lock.load();
+    EXPECT_EQ(value.a, 1u);
+    EXPECT_EQ(value.b, 2u);
+    EXPECT_EQ(value.c[4], 7.0f);
+
+    const auto copy = lock;
+    EXPECT_EQ(copy.load().b, 2u);
+}
+
+TEST(SeqLock, ReadersSeeConsistentValues)
+{
+    SeqLock<Value> lock;
+    std::atomic<bool> done{ false };
+    std::atomic<int> torn{ 0 };
+
+    std::thread reader([&]() {
+        while (!done.load()) {
+            const auto value = lock.load();
+            if (value.b != value.a * 2 || value.c[4] != static_cast<float>(value.a)) {
+                torn++;
+            }
+        }
+    });
+
+    for (uint64_t i = 0; i < 20000; i++) {
+        const auto f = static_cast<float>(i);
+        lock.store(Value{ i, i * 2, { f, f, f, f, f } });
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmt/SlotMap.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace slot_map
+{
+
+TEST(SlotMap, InsertGetErase)
+{
+    SlotMap<std::string> map;
+    const auto a = map.insert("a");
+    const auto b = map.emplace(3, 'b');
+    const auto c = map.insert("c");
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(*map.get(a), "a");
+    EXPECT_EQ(*map.get(b), "bbb");
+
+    // c moves into a's place, its handle still finds it.
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_EQ(map.get(a), nullptr);
+    EXPECT_EQ(*map.get(c), "c");
+    EXPECT_EQ(map.size(), 2u);
+
+    std::vector<std::string> values(map.begin(), map.end());
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<std::string>{ "bbb", "c" }));
+    for (size_t i = 0; i < map.size(); i++) {
+        EXPECT_EQ(map.get(map.handleAt(i)), map.data() + i);
+    }
+}
+
+TEST(SlotMap, StaleHandles)
+{
+    SlotMap<int> map;
+    EXPECT_EQ(map.get({}), nullptr);
+
+    const auto first = map.insert(1);
+    map.erase(first);
+
+    // The slot is reused with a new generation.
+    const auto second = map.insert(2);
+    EXPECT_EQ(second.index(), first.index());
+    EXPECT_NE(second, first);
+    EXPECT_EQ(map.get(first), nullptr);
+    EXPECT_EQ(*map.get(second), 2);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(second));
+}
+
+TEST(SlotMap, GenerationWrap)
+{
+    // A slot whose 8 bit generation is used up is retired, old handles never match again.
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::Handle> handles;
+    for (int i = 0; i < 300; i++) {
+        handles.push_back(map.insert(i));
+        map.erase(handles.back());
+    }
+
+    EXPECT_EQ(handles[0].index(), handles[254].index());
+    EXPECT_NE(handles[0].index(), handles[255].index());
+
+    const auto live = map.insert(-1);
+    for (const auto handle : handles) {
+        EXPECT_EQ(map.get(handle), nullptr);
+    }
+    EXPECT_EQ(*map.get(live), -1);
+}
+
+TEST(SlotMap, Wide)
+{
+    SlotMap<std::unique_ptr<int>, uint64_t> map;
+    std::vector<SlotMap<std::unique_ptr<int>, uint64_t>::Handle> handles;
+    for (int i = 0; i < 10000; i++) {
+        handles.push_back(map.insert(std::make_unique<int>(i)));
+    }
+    for (int i = 0; i < 10000; i += 3) {
+        map.erase(handles[i]);
+    }
+
+    for (int i = 0; i < 10000; i++) {
+        const auto *value = map.get(handles[i]);
+        if (i % 3 == 0) {
+            EXPECT_EQ(value, nullptr);
+        } else {
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(**value, i);
+        }
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <gmt/StaticSignal.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace static_signal
+{
+
+namespace
+{
+
+std::vector<int> calls;
+
+void first(int value)
+{
+    calls.push_back(value);
+}
+
+void second(const int &value)
+{
+    calls.push_back(value * 10);
+}
+
+struct Counter
+{
+    int count{ 0 };
+
+    void add(int value) { count += value; }
+};
+
+}
+
+TEST(StaticSignal, Order)
+{
+    calls.clear();
+
+    StaticSignal<StaticListeners<&first, &second, [](int value) { calls.push_back(-value); }>, int> signal;
+    static_assert(decltype(signal)::getListenersCount() == 3);
+
+    signal(2);
+    EXPECT_EQ(calls, (std::vector<int>{ 2, 20, -2 }));
+}
+
+TEST(StaticSignal, With)
+{
+    calls.clear();
+
+    using Signal = StaticSignal<StaticListeners<&first>, int>;
+    Signal::With<&second> signal;
+    static_assert(Signal::getListenersCount() == 1);
+    static_assert(decltype(signal)::getListenersCount() == 2);
+
+    signal(1);
+    EXPECT_EQ(calls, (std::vector<int>{ 1, 10 }));
+}
+
+TEST(StaticSignal, MemberFunction)
+{
+    StaticSignal<StaticListeners<&Counter::add>, Counter*, int> signal;
+
+    Counter counter;
+    signal(&counter, 3);
+    signal(&counter, 4);
+    EXPECT_EQ(counter.count, 7);
+}
+
+TEST(StaticSignal, Empty)
+{
+    StaticSignal<StaticListeners<>> signal;
+    signal();
+    EXPECT_EQ(signal.getListenersCount(), 0u);
+}
+
+}
+
+}
+
+}
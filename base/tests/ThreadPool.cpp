@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include <gmt/ThreadPool.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace thread_pool
+{
+
+TEST(ThreadPool, Submit)
+{
+    ThreadPool pool{ 2 };
+    auto a = pool.submit([]() { return 2; });
+    auto b = pool.submit([]() { return 3; });
+    EXPECT_EQ(a.get() + b.get(), 5);
+}
+
+TEST(ThreadPool, ParallelFor)
+{
+    ThreadPool pool{ 3 };
+    std::vector<int> values(1000, 0);
+    pool.parallelFor(values.size(), 7, [&values](size_t i) { values[i] += static_cast<int>(i); });
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(values[i], static_cast<int>(i));
+    }
+}
+
+TEST(ThreadPool, NestedParallelFor)
+{
+    ThreadPool pool{ 2 };
+    std::atomic<int> sum{ 0 };
+    pool.parallelFor(4, 1, [&pool, &sum](size_t) {
+        pool.parallelFor(100, 10, [&sum](size_t) { sum++; });
+    });
+    EXPECT_EQ(sum.load(), 400);
+}
+
+TEST(ThreadPool, DestructorRunsQueuedTasks)
+{
+    std::atomic<int> count{ 0 };
+    {
+        ThreadPool pool{ 1 };
+        for (int i = 0; i < 16; i++) {
+            (void)pool.submit([&count]() { count++; });
+        }
+    }
+    EXPECT_EQ(count.load(), 16);
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <gmt/ThreadPool.h>
+#include <gmt/math/TransformHierarchy.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace transform_hierarchy
+{
+
+namespace
+{
+
+glm::mat4 trs(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    return glm::translate(glm::mat4{ 1.0f }, position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4{ 1.0f }, scale);
+}
+
+void expectNear(const glm::mat4 &actual, const glm::mat4 &expected)
+{
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            EXPECT_NEAR(actual[c][r], expected[c][r], 1e-4f) << "column " << c << " row " << r;
+        }
+    }
+}
+
+}
+
+TEST(TransformHierarchy, World)
+{
+    TransformHierarchy hierarchy;
+    const auto root = hierarchy.create();
+    const auto child = hierarchy.create(root);
+    const auto grandchild = hierarchy.create(child);
+
+    const auto rotation = glm::angleAxis(0.7f, glm::normalize(glm::vec3{ 1.0f, 2.0f, 3.0f }));
+    hierarchy.setLocal(root, { 1.0f, 2.0f, 3.0f }, rotation, { 2.0f, 2.0f, 2.0f });
+    hierarchy.setPosition(child, { 0.0f, 1.0f, 0.0f });
+    hierarchy.setScale(child, { 1.0f, 3.0f, 0.5f });
+    hierarchy.setRotation(grandchild, glm::angleAxis(-0.3f, glm::vec3{ 0.0f, 0.0f, 1.0f }));
+
+    EXPECT_EQ(hierarchy.update(), 3u);
+
+    const auto rootWorld = trs({ 1.0f, 2.0f, 3.0f }, rotation, { 2.0f, 2.0f, 2.0f });
+    const auto childWorld = rootWorld * trs({ 0.0f, 1.0f, 0.0f }, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 3.0f, 0.5f });
+    const auto grandchildWorld = childWorld * glm::mat4_cast(glm::angleAxis(-0.3f, glm::vec3{ 0.0f, 0.0f, 1.0f }));
+    expectNear(hierarchy.getWorld(root), rootWorld);
+    expectNear(hierarchy.getWorld(child), childWorld);
+    expectNear(hierarchy.getWorld(grandchild), grandchildWorld);
+
+    const TransformHierarchy::Node nodes[] = { grandchild, root };
+    glm::mat4 gathered[2];
+    hierarchy.gatherWorld(gathered, nodes, 2);
+    EXPECT_EQ(gathered[0], hierarchy.getWorld(grandchild));
+    EXPECT_EQ(gathered[1], hierarchy.getWorld(root));
+}
+
+TEST(TransformHierarchy, DirtySubtrees)
+{
+    TransformHierarchy hierarchy;
+    const auto a = hierarchy.create();
+    const auto b = hierarchy.create();
+    const auto a1 = hierarchy.create(a);
+    const auto a2 = hierarchy.create(a);
+    hierarchy.create(b);
+    const auto a11 = hierarchy.create(a1);
+
+    EXPECT_EQ(hierarchy.update(), 6u);
+    EXPECT_EQ(hierarchy.update(), 0u);
+
+    // A change reaches the node and its descendants only.
+    hierarchy.setPosition(a1, { 1.0f, 0.0f, 0.0f });
+    EXPECT_EQ(hierarchy.update(), 2u);
+    hierarchy.setPosition(a, { 0.0f, 1.0f, 0.0f });
+    EXPECT_EQ(hierarchy.update(), 4u);
+
+    expectNear(hierarchy.getWorld(a11), glm::translate(glm::mat4{ 1.0f }, glm::vec3{ 1.0f, 1.0f, 0.0f }));
+    expectNear(hierarchy.getWorld(a2), glm::translate(glm::mat4{ 1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }));
+}
+
+TEST(TransformHierarchy, Reparent)
+{
+    TransformHierarchy hierarchy;
+    const auto a = hierarchy.create();
+    const auto b = hierarchy.create(a);
+    const auto c = hierarchy.create();
+    const auto d = hierarchy.create(c);
+    hierarchy.setPosition(a, { 1.0f, 0.0f, 0.0f });
+    hierarchy.setPosition(b, { 0.0f, 1.0f, 0.0f });
+    hierarchy.setPosition(c, { 0.0f, 0.0f, 1.0f });
+    hierarchy.setPosition(d, { 0.0f, 0.0f, 2.0f });
+    hierarchy.update();
+
+    // c's subtree moves under b, two levels deeper.
+    hierarchy.setParent(c, b);
+    EXPECT_EQ(hierarchy.getParent(c), b);
+    EXPECT_EQ(hierarchy.update(), 2u);
+    expectNear(hierarchy.getWorld(d), glm::translate(glm::mat4{ 1.0f }, glm::vec3{ 1.0f, 1.0f, 3.0f }));
+
+    hierarchy.setParent(b, TransformHierarchy::none);
+    EXPECT_EQ(hierarchy.getParent(b), TransformHierarchy::none);
+    hierarchy.update();
+    expectNear(hierarchy.getWorld(d), glm::translate(glm::mat4{ 1.0f }, glm::vec3{ 0.0f, 1.0f, 3.0f }));
+}
+
+TEST(TransformHierarchy, Destroy)
+{
+    TransformHierarchy hierarchy;
+    const auto a = hierarchy.create();
+    const auto b = hierarchy.create(a);
+    const auto c = hierarchy.create(b);
+    const auto d = hierarchy.create();
+    hierarchy.setPosition(d, { 5.0f, 0.0f, 0.0f });
+    hierarchy.update();
+
+    hierarchy.destroy(b);
+    EXPECT_EQ(hierarchy.size(), 2u);
+    EXPECT_TRUE(hierarchy.valid(a));
+    EXPECT_FALSE(hierarchy.valid(b));
+    EXPECT_FALSE(hierarchy.valid(c));
+    expectNear(hierarchy.getWorld(d), glm::translate(glm::mat4{ 1.0f }, glm::vec3{ 5.0f, 0.0f, 0.0f }));
+
+    // Handles are reused.
+    const auto e = hierarchy.create(d);
+    EXPECT_TRUE(e == b || e == c);
+    EXPECT_EQ(hierarchy.update(), 1u);
+    expectNear(hierarchy.getWorld(e), glm::translate(glm::mat4{ 1.0f }, glm::vec3{ 5.0f, 0.0f, 0.0f }));
+}
+
+TEST(TransformHierarchy, Parallel)
+{
+    // Wide levels, split across the pool.
+    TransformHierarchy serial;
+    TransformHierarchy parallel;
+    std::vector<TransformHierarchy::Node> nodes;
+    for (auto *hierarchy : { &serial, &parallel }) {
+        nodes.clear();
+        for (int i = 0; i < 8; i++) {
+            nodes.push_back(hierarchy->create());
+        }
+        for (int i = 0; i < 20000; i++) {
+            const auto node = hierarchy->create(nodes[(i * 7) % std::min<size_t>(nodes.size(), 256)]);
+            const auto f = static_cast<float>(i);
+            hierarchy->setLocal(node, { f, -f, 0.5f * f }, glm::angleAxis(f * 0.01f, glm::vec3{ 0.0f, 1.0f, 0.0f }),
+                glm::vec3{ 1.0f + static_cast<float>(i % 10) * 0.01f });
+            nodes.push_back(node);
+        }
+    }
+
+    ThreadPool pool{ 3 };
+    EXPECT_EQ(serial.update(), nodes.size());
+    EXPECT_EQ(parallel.update(&pool, 1024), nodes.size());
+    for (const auto node : nodes) {
+        ASSERT_EQ(serial.getWorld(node), parallel.getWorld(node));
+    }
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <gmt/ThreadPool.h>
+#include <gmt/math/Trs.h>
+
+namespace gmt
+{
+
+namespace tests
+{
+
+namespace trs
+{
+
+namespace
+{
+
+TrsArray randomTrs(size_t count)
+{
+    TrsArray result;
+    for (size_t i = 0; i < count; i++) {
+        const auto f = static_cast<float>(i);
+        result.push_back({ f, 2.0f * f, -f }, glm::angleAxis(f * 0.37f, glm::normalize(glm::vec3{ 1.0f, f, 2.0f })),
+            { 1.0f + f * 0.01f, 0.5f, 2.0f });
+    }
+    return result;
+}
+
+}
+
+TEST(Trs, ToMatrix)
+{
+    const glm::vec3 position{ 1.0f, -2.0f, 3.0f };
+    const auto rotation = glm::angleAxis(1.1f, glm::normalize(glm::vec3{ 3.0f, 1.0f, -2.0f }));
+    const glm::vec3 scale{ 2.0f, 0.5f, 3.0f };
+
+    const auto expected = glm::translate(glm::mat4{ 1.0f }, position) * glm::mat4_cast(rotation)
+        * glm::scale(glm::mat4{ 1.0f }, scale);
+    const auto actual = gmt::trs::toMatrix(position, rotation, scale);
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            EXPECT_NEAR(actual[c][r], expected[c][r], 1e-5f);
+        }
+    }
+}
+
+TEST(Trs, Batch)
+{
+    const auto trs = randomTrs(100);
+    std::vector<glm::mat4> matrices(trs.size());
+    std::vector<glm::mat3x4> compact(trs.size());
+    gmt::trs::toMatrices(trs, matrices.data());
+    gmt::trs::toMatrices(trs, compact.data());
+
+    for (size_t i = 0; i < trs.size(); i++) {
+        const auto expected = gmt::trs::toMatrix({ trs.positionX[i], trs.positionY[i], trs.positionZ[i] },
+            glm::quat{ trs.rotationW[i], trs.rotationX[i], trs.rotationY[i], trs.rotationZ[i] },
+            { trs.scaleX[i], trs.scaleY[i], trs.scaleZ[i] });
+        EXPECT_EQ(matrices[i], expected);
+
+        // The compact form transforms row vectors like the full one transforms column vectors.
+        const glm::vec4 p{ 1.0f, 2.0f, 3.0f, 1.0f };
+        const auto transformed = p * compact[i];
+        const auto expectedPoint = expected * p;
+        EXPECT_NEAR(transformed.x, expectedPoint.x, 1e-4f);
+        EXPECT_NEAR(transformed.y, expectedPoint.y, 1e-4f);
+        EXPECT_NEAR(transformed.z, expectedPoint.z, 1e-4f);
+    }
+}
+
+TEST(Trs, Parallel)
+{
+    const auto trs = randomTrs(50000);
+    std::vector<glm::mat4> serial(trs.size());
+    std::vector<glm::mat4> parallel(trs.size());
+    std::vector<glm::mat3x4> compactSerial(trs.size());
+    std::vector<glm::mat3x4> compactParallel(trs.size());
+
+    ThreadPool pool{ 3 };
+    gmt::trs::toMatrices(trs, serial.data());
+    gmt::trs::toMatrices(trs, parallel.data(), &pool);
+    gmt::trs::toMatrices(trs, compactSerial.data());
+    gmt::trs::toMatrices(trs, compactParallel.data(), &pool);
+    EXPECT_EQ(serial, parallel);
+    EXPECT_EQ(compactSerial, compactParallel);
+}
+
+TEST(Trs, Resize)
+{
+    TrsArray trs;
+    trs.resize(2);
+    glm::mat4 matrices[2];
+    gmt::trs::toMatrices(trs, matrices);
+    EXPECT_EQ(matrices[0], glm::mat4{ 1.0f });
+    EXPECT_EQ(matrices[1], glm::mat4{ 1.0f });
+}
+
+}
+
+}
+
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <gmt/Weak.h>
 
 namespace gmt
@@ -22,6 +27,22 @@ public:
 	}
 };
 
+class Shared : public gmt::EnableAtomicWeakFromThis<Shared>
+{
+public:
+	Shared() : gmt::EnableAtomicWeakFromThis<Shared>(this)
+	{
+	}
+
+	~Shared()
+	{
+		expireWeak();
+		alive = false;
+	}
+
+	std::atomic<bool> alive{ true };
+};
+
 }
 TEST(Weak, Basic)
 {
@@ -103,6 +124,78 @@ TEST(Weak, CopyWeakAndNullify)
 	EXPECT_EQ(w2.get(), nullptr);
 }
 
+TEST(Weak, ManyObjects)
+{
+	// Control blocks come from the pool, freed ones are reused.
+	std::vector<std::unique_ptr<A>> objects;
+	std::vector<gmt::Weak<A>> weaks;
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 2000; i++) {
+			objects.push_back(std::make_unique<A>());
+			weaks.push_back(objects.back()->weak());
+		}
+		for (size_t i = 0; i < objects.size(); i++) {
+			EXPECT_EQ(weaks[i].get(), objects[i].get());
+		}
+		objects.clear();
+		for (const auto &w : weaks) {
+			EXPECT_EQ(w.get(), nullptr);
+		}
+		weaks.clear();
+	}
+}
+
+TEST(AtomicWeak, Basic)
+{
+	gmt::AtomicWeak<Shared> w;
+	EXPECT_FALSE(w.lock());
+	{
+		Shared shared;
+		w = shared.weak();
+		auto copy = w;
+		EXPECT_EQ(copy.get(), &shared);
+
+		auto pin = copy.lock();
+		EXPECT_EQ(pin.get(), &shared);
+	}
+	EXPECT_EQ(w.get(), nullptr);
+	EXPECT_FALSE(w.lock());
+}
+
+TEST(AtomicWeak, Threads)
+{
+	// Workers pin while the owner is destroyed, a pinned object is never destroyed.
+	for (int round = 0; round < 20; round++) {
+		auto shared = std::make_unique<Shared>();
+		const auto w = shared->weak();
+
+		std::atomic<int> started{ 0 };
+		std::vector<std::thread> workers;
+		for (int i = 0; i < 3; i++) {
+			workers.emplace_back([w, &started]() {
+				started++;
+				for (;;) {
+					auto pin = w.lock();
+					if (!pin) {
+						return;
+					}
+					EXPECT_TRUE(pin->alive.load());
+					auto copy = w;
+				}
+			});
+		}
+
+		while (started.load() < 3) {
+			std::this_thread::yield();
+		}
+		shared.reset();
+		for (auto &worker : workers) {
+			worker.join();
+		}
+		EXPECT_EQ(w.get(), nullptr);
+	}
+}
+
 }
 
 }
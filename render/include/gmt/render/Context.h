@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "gmt/EventQueue.h"
 #include "gmt/Observable.h"
 
 namespace gmt
@@ -19,12 +20,23 @@ public:
     virtual void onResize(int width, int height) = 0;
 };
 
+struct ContextResize
+{
+    int width{ 0 };
+    int height{ 0 };
+};
+
 class Context : public Observable<ContextListener>
 {
 public:
     int width() const { return width_; }
     int height() const { return height_; }
 
+    // Deferred notifications are queued and reach the listeners from dispatchEvents(), once
+    // per frame: a burst of resizes becomes a single onResize with the last size.
+    void setDeferredEvents(bool deferred) { deferredEvents_ = deferred; }
+    void dispatchEvents();
+
 protected:
     Context() = default;
 
@@ -36,6 +48,11 @@ protected:
 private:
     int width_{ 0 };
     int height_{ 0 };
+
+    bool deferredEvents_{ false };
+    EventQueue<ContextResize> resizes_{ EventCoalescing::KeepLast };
+
+    void notifyResize(int width, int height);
 };
 
 }
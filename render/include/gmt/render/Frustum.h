@@ -1,10 +1,16 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "gmt/Observable.h"
+#include "gmt/SeqLock.h"
+#include "gmt/math/Bounds.h"
 #include "gmt/math/Plane.h"
+#include "gmt/math/Ray.h"
 
 namespace gmt
 {
@@ -17,17 +23,41 @@ public:
     virtual void onViewProjChanged() = 0;
 };
 
+// Matrices as of the last Frustum::update(), safe to read from any thread.
+struct FrustumSnapshot
+{
+    glm::mat4 view;
+    glm::mat4 proj;
+    glm::mat4 viewProj;
+    glm::mat4 invViewProj;
+    float near;
+    float far;
+    uint64_t version; // viewProj version
+};
+
 class Frustum : public Observable<FrustumListener>
 {
 public:
+    enum class DepthMode
+    {
+        // OpenGL's default, near maps to -1 and far to 1.
+        Standard,
+
+        // Near maps to 1 and far to 0. Needs glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE),
+        // glDepthFunc(GL_GREATER) and a depth clear to 0, a float depth buffer gets the most of it.
+        Reversed,
+    };
+
     Frustum()
         : mPlanesDirty(true), mViewProjDirty(true)
         , mInvViewProjDirty(true), mCornersDirty(true) {}
 
+    // zFar may be std::numeric_limits<float>::infinity() for an infinite far plane.
     void projSetPerspective(const float &fovy, const float &aspect,
-        const float &zNear, const float &zFar);
+        const float &zNear, const float &zFar, DepthMode depthMode = DepthMode::Standard);
     
-    void projSetOrtho(float left, float right, float bottom, float top, float near, float far);
+    void projSetOrtho(float left, float right, float bottom, float top, float near, float far,
+        DepthMode depthMode = DepthMode::Standard);
 
     void viewSetIdentity();
     void viewRotate(float angle, glm::vec3 axis);
@@ -44,8 +74,21 @@ public:
     const glm::mat4 &getInvViewProj() const;
     const glm::mat3 &getNormal() const;
 
+    // Incremented on every change, consumers compare them with the version they last saw.
+    uint64_t getViewVersion() const { return mViewVersion; }
+    uint64_t getProjVersion() const { return mProjVersion; }
+    uint64_t getViewProjVersion() const { return mViewVersion + mProjVersion; }
+
+    FrustumSnapshot getSnapshot() const { return mSnapshot.load(); }
+
     float getNear() const { return mNear; }
     float getFar() const { return mFar; }
+    bool isFarInfinite() const { return std::isinf(mFar); }
+    DepthMode getDepthMode() const { return mDepthMode; }
+
+    // Normalized device depth of the near and far planes.
+    float getNearDepth() const { return mDepthMode == DepthMode::Reversed ? 1.0f : -1.0f; }
+    float getFarDepth() const { return mDepthMode == DepthMode::Reversed ? 0.0f : 1.0f; }
 
     const float *getViewPtr() const { return glm::value_ptr(getView()); }
     const float *getProjPtr() const { return glm::value_ptr(getProj()); }
@@ -53,19 +96,39 @@ public:
     const float *getInvViewProjPtr() const { return glm::value_ptr(getInvViewProj()); }
     const float *getNormalPtr() const { return glm::value_ptr(getView()); }
 
-    /*  0: (-1, -1, -1)
-        1: ( 1, -1, -1)
-        2: ( 1,  1, -1)
-        3: (-1,  1, -1)
-        4: (-1, -1,  1)
-        5: ( 1, -1,  1) 
-        6: ( 1,  1,  1) 
-        7: (-1,  1,  1)
+    /*  0: (-1, -1, near)
+        1: ( 1, -1, near)
+        2: ( 1,  1, near)
+        3: (-1,  1, near)
+        4: (-1, -1,  far)
+        5: ( 1, -1,  far) 
+        6: ( 1,  1,  far) 
+        7: (-1,  1,  far)
+        With an infinite far plane the far corners are directions, their w is 0.
     */
     const glm::vec4 &getCorner(int index) const;
 
+    // Left, right, bottom, top, near and far, normals point inside.
+    // The far plane of an infinite projection is invalid.
     const Plane &getPlane(int index) const;
+
+    // Conservative culling tests against the six planes.
+    bool intersects(const Aabb &box) const;
+    bool intersects(const Sphere &sphere) const;
+
+    // Ray from the near plane through a point in normalized device coordinates, direction is normalized.
+    Ray unproject(const glm::vec2 &ndc) const;
+
+    // Same for window coordinates with the origin in the top left corner, as mouse events report them.
+    Ray unproject(float x, float y, float width, float height) const;
+
+    // Screen pixels per world unit at the nearest point of bounds, for picking levels of detail.
+    // Bounds containing the eye of a perspective projection use the near plane.
+    float getPixelsPerUnit(const Sphere &bounds, float viewportHeight) const;
     
+    // Computes the cached matrices, notifies listeners and publishes the snapshot if the
+    // frustum changed since the previous update. Getters are not thread safe, other threads
+    // should use getSnapshot().
     void update();
     
 private:
@@ -77,6 +140,9 @@ private:
     
     float mNear{ 1.0f };
     float mFar{ 10.0f };
+    DepthMode mDepthMode{ DepthMode::Standard };
+
+    glm::mat4 mInvProj;
     
     mutable glm::mat4 mViewProj;
     mutable bool mViewProjDirty;
@@ -89,7 +155,15 @@ private:
     
     mutable glm::mat3 mNormal;
     mutable bool mNormalDirty{ true };
-    
+
+    uint64_t mViewVersion{ 0 };
+    uint64_t mProjVersion{ 0 };
+    uint64_t mUpdatedVersion{ 0 };
+
+    SeqLock<FrustumSnapshot> mSnapshot;
+
+    void viewChanged();
+    void projChanged();
     void changed();
     void computePlanes() const;
 };
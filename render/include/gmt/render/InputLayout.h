@@ -42,11 +42,24 @@ enum class InputLayoutEditorEvent
 
 class InputLayout;
 
+// Storage of an attribute in the vertex buffer, gmt/mesh/Quantize.h packs data into these formats.
 enum class ScalarType
 {
     Default,
     Float,
+    HalfFloat,
+    Byte,
     UnsignedByte,
+    Short,
+    UnsignedShort,
+
+    // Four components in 32 bits, x in the low bits, componentsCount must be 4.
+    Int2101010Rev,
+    UnsignedInt2101010Rev,
+
+    // Unit vector as two normalized shorts, the shader declares a vec2 e and decodes it with
+    // n = vec3(e, 1.0 - abs(e.x) - abs(e.y)); n.xy -= sign(n.xy) * max(-n.z, 0.0); n = normalize(n);
+    OctahedralNormal,
 };
 
 class InputLayoutEditor
@@ -57,6 +70,8 @@ public:
     }
 
     InputLayoutEditor &bind(const VertexBuffer *buffer);
+
+    // Matrix attributes take a location per column, componentsCount applies to each column.
     InputLayoutEditor& setAttribute(const std::string& name, bool normalized, GLsizei stride,
         void* ptr, int instanced = 0, int componentsCount = 0,
         ScalarType scalarType = ScalarType::Default);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "gmt/math/Trs.h"
+
+namespace gmt
+{
+
+// Per-instance transform formats smaller than a mat4 (64 bytes):
+//
+// - mat3x4 (48 bytes): the affine matrix without its constant last row, written by
+//   trs::toMatrices(trs, glm::mat3x4*). The shader declares `in mat3x4 m` or three split vec4
+//   rows and transforms with instanceTransform().
+// - InstanceTrs (32 bytes): position, uniform scale and rotation, written by packInstances().
+//   The shader declares two vec4 and transforms with instanceTransform(positionScale, rotation, p).
+//
+// Both need instanceGlsl prepended to the vertex shader, e.g. as the defines of Program.
+
+struct InstanceTrs
+{
+    // xyz position, w uniform scale.
+    glm::vec4 positionScale;
+
+    // Unit quaternion, xyz vector part and w scalar part.
+    glm::vec4 rotation;
+};
+
+static_assert(sizeof(InstanceTrs) == 8 * sizeof(float));
+
+// Packs trs.size() instances, scale is taken from scaleX. Non-uniform scale needs the mat3x4 format.
+void packInstances(const TrsArray &trs, InstanceTrs *destination);
+
+// GLSL helpers for the formats above.
+extern const char *const instanceGlsl;
+
+}
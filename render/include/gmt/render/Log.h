@@ -0,0 +1,11 @@
+#pragma once
+
+#include "gmt/Logger.h"
+
+namespace gmt
+{
+
+// Messages of the render library, e.g. shader compilation and reflection.
+inline LogCategory renderLog{ "render" };
+
+}
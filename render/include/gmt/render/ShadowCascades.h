@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "gmt/math/Bounds.h"
+#include "gmt/render/Frustum.h"
+
+namespace gmt
+{
+
+struct ShadowCascade
+{
+    // View space distances covered by the cascade.
+    float splitNear;
+    float splitFar;
+
+    // World space bounds of the camera slice, the light projection encloses it.
+    Sphere bounds;
+
+    glm::mat4 view;
+    glm::mat4 proj;
+    glm::mat4 viewProj;
+};
+
+// Splits a camera frustum into cascades and fits a directional light's orthographic frustum
+// to each of them. The fit is stable: the projection size only depends on the slice shape
+// and the light space origin moves in whole texels, so shadows don't swim while the camera moves.
+class ShadowCascades
+{
+public:
+    // Cascades per instance, update() returns them as a bitmask.
+    static constexpr int maxCount = 32;
+
+    // Practical split scheme, lambda blends between uniform (0) and logarithmic (1) splits.
+    // distances receives count + 1 values from near to far. Splits are uniform if near isn't
+    // positive, e.g. for orthographic cameras.
+    static void computeSplits(float near, float far, int count, float lambda, float *distances);
+
+    ShadowCascades(int count, int resolution);
+
+    void setSplitLambda(float lambda) { lambda_ = lambda; }
+
+    // Cascades end at this distance if it's closer than the camera far plane, required for
+    // cameras with an infinite far plane.
+    void setMaxDistance(float distance) { maxDistance_ = distance; }
+
+    // Extends the light frusta towards the light so casters outside the camera still cast.
+    void setCastersDistance(float distance) { castersDistance_ = distance; }
+
+    void setResolution(int resolution) { resolution_ = resolution; }
+
+    // Recomputes every cascade, returns the bitmask of cascades whose light frustum changed and
+    // have to be rendered again.
+    uint32_t update(const Frustum &camera, const glm::vec3 &lightDirection);
+
+    int count() const { return static_cast<int>(cascades_.size()); }
+    const ShadowCascade &cascade(int index) const { return cascades_[index]; }
+
+    // splitFar of every cascade, the layout shaders use to pick a cascade.
+    const float *getSplitsPtr() const { return splits_.data(); }
+
+private:
+    std::vector<ShadowCascade> cascades_;
+    std::vector<float> splits_;
+
+    int resolution_;
+    float lambda_{ 0.75f };
+    float maxDistance_{ std::numeric_limits<float>::infinity() };
+    float castersDistance_{ 0.0f };
+};
+
+}
@@ -9,7 +9,21 @@
 namespace gmt
 {
 
+void Context::dispatchEvents()
+{
+    resizes_.dispatch([this](const ContextResize &resize, size_t) { notifyResize(resize.width, resize.height); });
+}
+
 void Context::onResize(int width, int height)
+{
+    if (deferredEvents_) {
+        resizes_.push({ width, height });
+    } else {
+        notifyResize(width, height);
+    }
+}
+
+void Context::notifyResize(int width, int height)
 {
     notify([width, height](auto x){ x->onResize(width, height); });
 }
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <array>
 
+#include "gmt/render/Log.h"
 #include "gmt/Debug.h"
 #include "gmt/Utils.h"
 
@@ -19,19 +20,19 @@ bool isFramebufferOk(GLenum err)
         return true;
 
     case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT:
-        utils::log("GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT");
+        GMT_LOG_ERROR(renderLog, "GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT");
         break;
 
     case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT:
-        utils::log("GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT");
+        GMT_LOG_ERROR(renderLog, "GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT");
         break;
 
     case GL_FRAMEBUFFER_UNSUPPORTED:
-        utils::log("GL_FRAMEBUFFER_UNSUPPORTED");
+        GMT_LOG_ERROR(renderLog, "GL_FRAMEBUFFER_UNSUPPORTED");
         break;
         
     default:
-        utils::logf("Unknown framebuffer error: {}", err);
+        GMT_LOG_ERROR(renderLog, "Unknown framebuffer error: {}", err);
     }
     return false;
 }
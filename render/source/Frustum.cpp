@@ -1,6 +1,9 @@
 #include "gmt/render/Frustum.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <iterator>
 
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/matrix_access.hpp"
@@ -17,31 +20,14 @@ Plane createNormalizedPlane(const glm::vec4 &equation)
 {
     const auto length = glm::length(glm::vec3(equation));
     assert(length > 1.0e-06);
-    const auto a = equation.x / length;
-    const auto b = equation.y / length;
-    const auto c = equation.z / length;
-    const auto d = equation.w;
-
-    const auto lowestComponent = 1.0f / sqrt(3.0f) * 0.75f;
-
-    glm::vec3 u;
-    glm::vec3 v;
-    glm::vec3 origin;
-
-    if (a > lowestComponent) {
-        u = { -b / a, 1.0f, 0.0f };
-        v = { -c / a, 0.0f, 1.0f };
-        origin = { -d / a, 0.0f, 0.0f };
-    } else if (b > lowestComponent) {
-        u = { 1.0f, -a / b, 0.0f };
-        v = { 0.0f, -c / b, 1.0f };
-        origin = { 0.0f, -d / b, 0.0f };
-    } else {
-        assert(c > lowestComponent);
-        u = { 1.0f, 0.0f, -a / c };
-        v = { 0.0f, 1.0f, -b / c };
-        origin = { 0.0f, 0.0f, -d / c };
-    }
+    const auto n = glm::vec3(equation) / length;
+    const auto d = equation.w / length;
+
+    // Any orthonormal u, v with u x v == n, the dominant component may have either sign.
+    const auto helper = std::abs(n.x) < 0.57f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    const auto u = glm::normalize(glm::cross(n, helper));
+    const auto v = glm::cross(n, u);
+    const auto origin = -n * d;
 
     return Plane(origin, origin + u, origin + v);
 }
@@ -67,8 +53,12 @@ void Frustum::computePlanes() const
     mPlanes[2] = createNormalizedPlane(rows[3] + rows[1]);
     mPlanes[3] = createNormalizedPlane(rows[3] - rows[1]);
     
-    mPlanes[4] = createNormalizedPlane(rows[3] + rows[2]);
-    mPlanes[5] = createNormalizedPlane(rows[3] - rows[2]);
+    // Clip space depth runs from -w to w, or from w down to 0 with reversed depth.
+    const auto reversed = mDepthMode == DepthMode::Reversed;
+    mPlanes[4] = createNormalizedPlane(reversed ? rows[3] - rows[2] : rows[3] + rows[2]);
+
+    // An infinite far plane has no equation, its coefficients are all 0.
+    mPlanes[5] = isFarInfinite() ? Plane{} : createNormalizedPlane(reversed ? rows[2] : rows[3] - rows[2]);
 
     mPlanesDirty = false;
 }
@@ -79,15 +69,34 @@ const Plane &Frustum::getPlane(int index) const
     return mPlanes[index];
 }
 
+bool Frustum::intersects(const Aabb &box) const
+{
+    computePlanes();
+    return std::none_of(std::begin(mPlanes), std::end(mPlanes), [&box](const auto &p) { return p && box.outside(p); });
+}
+
+bool Frustum::intersects(const Sphere &sphere) const
+{
+    computePlanes();
+    return std::none_of(std::begin(mPlanes), std::end(mPlanes), [&sphere](const auto &p) { return p && sphere.outside(p); });
+}
+
+float Frustum::getPixelsPerUnit(const Sphere &bounds, float viewportHeight) const
+{
+    const auto scale = mProj[1][1] * viewportHeight * 0.5f;
+    if (mProj[3][3] != 0.0f) {
+        return scale;
+    }
+
+    const auto depth = -(mView * glm::vec4{ bounds.center, 1.0f }).z - bounds.radius;
+    return scale / std::max(depth, mNear);
+}
+
 const glm::mat4 &Frustum::getViewProj() const 
 {
     if (mViewProjDirty) {
         mViewProj = mProj * mView;
         mViewProjDirty = false;
-        
-        notify([](auto *x){
-            x->onViewProjChanged();
-        });
     }
 
     return mViewProj;
@@ -96,7 +105,8 @@ const glm::mat4 &Frustum::getViewProj() const
 const glm::mat4 &Frustum::getInvViewProj() const
 {
     if (mInvViewProjDirty) {
-        mInvViewProj = glm::inverse(getViewProj());
+        // The projection is inverted analytically, a general inverse loses precision with small near planes.
+        mInvViewProj = glm::inverse(mView) * mInvProj;
         mInvViewProjDirty = false;
     }
 
@@ -123,6 +133,18 @@ const glm::mat4 &Frustum::getProj() const
     return mProj;
 }
 
+void Frustum::viewChanged()
+{
+    mViewVersion++;
+    changed();
+}
+
+void Frustum::projChanged()
+{
+    mProjVersion++;
+    changed();
+}
+
 void Frustum::changed() 
 {
     mPlanesDirty = true;
@@ -132,20 +154,22 @@ void Frustum::changed()
     mNormalDirty = true;
 }
 
-static const glm::vec4 CUBE[] = {
-    glm::vec4(-1, -1, -1, 1), glm::vec4(1, -1, -1, 1), 
-    glm::vec4(1, 1, -1, 1), glm::vec4(-1, 1, -1, 1), 
-    glm::vec4(-1, -1, 1, 1), glm::vec4(1, -1, 1, 1), 
-    glm::vec4(1, 1, 1, 1), glm::vec4(-1, 1, 1, 1)
+static const glm::vec2 SQUARE[] = {
+    glm::vec2(-1, -1), glm::vec2(1, -1), 
+    glm::vec2(1, 1), glm::vec2(-1, 1)
 };
 
 const glm::vec4 &Frustum::getCorner(int index) const
 {
     if (mCornersDirty) {
         const glm::mat4 &invViewProj = getInvViewProj();
-        for (int i = 0; i < 8; i++) {
-            mCorners[i] = invViewProj * CUBE[i];
+        for (int i = 0; i < 4; i++) {
+            mCorners[i] = invViewProj * glm::vec4(SQUARE[i], getNearDepth(), 1.0f);
             mCorners[i] /= mCorners[i].w;
+            mCorners[i + 4] = invViewProj * glm::vec4(SQUARE[i], getFarDepth(), 1.0f);
+            if (!isFarInfinite()) {
+                mCorners[i + 4] /= mCorners[i + 4].w;
+            }
         }
         mCornersDirty = false;
     }
@@ -153,45 +177,102 @@ const glm::vec4 &Frustum::getCorner(int index) const
     return (index >= 0 && index < 8) ? mCorners[index] : mCorners[0];
 }
 
-void Frustum::projSetOrtho(float left, float right, float bottom, float top, float near, float far)
+Ray Frustum::unproject(const glm::vec2 &ndc) const
+{
+    const auto &invViewProj = getInvViewProj();
+    auto near = invViewProj * glm::vec4(ndc, getNearDepth(), 1.0f);
+    near /= near.w;
+
+    // far.w is 0 for an infinite far plane, far is the direction then.
+    const auto far = invViewProj * glm::vec4(ndc, getFarDepth(), 1.0f);
+    return Ray{ glm::vec3(near), glm::normalize(glm::vec3(far) - glm::vec3(near) * far.w) };
+}
+
+Ray Frustum::unproject(float x, float y, float width, float height) const
 {
+    return unproject(glm::vec2(2.0f * x / width - 1.0f, 1.0f - 2.0f * y / height));
+}
+
+void Frustum::projSetOrtho(float left, float right, float bottom, float top, float near, float far,
+    DepthMode depthMode)
+{
+    assert(std::isfinite(far));
     mNear = near;
     mFar = far;
-    mProj = glm::ortho(left, right, bottom, top, near, far);
-    changed();
+    mDepthMode = depthMode;
+    mProj = depthMode == DepthMode::Reversed
+        ? glm::orthoRH_ZO(left, right, bottom, top, far, near)
+        : glm::ortho(left, right, bottom, top, near, far);
+    mInvProj = glm::inverse(mProj);
+    projChanged();
 }
 
 void Frustum::projSetPerspective(const float &fovy, const float &aspect,
-    const float &zNear, const float &zFar)
+    const float &zNear, const float &zFar, DepthMode depthMode)
 {
+    assert(zNear > 0.0f && zFar > zNear);
     mNear = zNear;
     mFar = zFar;
-    mProj = glm::perspective(fovy, aspect, zNear, zFar);
-    changed();
+    mDepthMode = depthMode;
+
+    // Clip z = c * z + d, clip w = -z.
+    const auto reversed = depthMode == DepthMode::Reversed;
+    float c;
+    float d;
+    if (isFarInfinite()) {
+        c = reversed ? 0.0f : -1.0f;
+        d = reversed ? zNear : -2.0f * zNear;
+    } else if (reversed) {
+        c = zNear / (zFar - zNear);
+        d = zFar * zNear / (zFar - zNear);
+    } else {
+        c = -(zFar + zNear) / (zFar - zNear);
+        d = -2.0f * zFar * zNear / (zFar - zNear);
+    }
+
+    const auto tanHalfFovy = std::tan(fovy / 2.0f);
+    const auto a = 1.0f / (aspect * tanHalfFovy);
+    const auto b = 1.0f / tanHalfFovy;
+
+    mProj = glm::mat4(0.0f);
+    mProj[0][0] = a;
+    mProj[1][1] = b;
+    mProj[2][2] = c;
+    mProj[2][3] = -1.0f;
+    mProj[3][2] = d;
+
+    mInvProj = glm::mat4(0.0f);
+    mInvProj[0][0] = 1.0f / a;
+    mInvProj[1][1] = 1.0f / b;
+    mInvProj[2][3] = 1.0f / d;
+    mInvProj[3][2] = -1.0f;
+    mInvProj[3][3] = c / d;
+
+    projChanged();
 }
 
 void Frustum::viewSetIdentity()
 {
     mView = glm::mat4(1);
-    changed();
+    viewChanged();
 }
 
 void Frustum::viewRotate(float angle, glm::vec3 axis)
 {
     mView = glm::rotate(mView, angle, axis);
-    changed();
+    viewChanged();
 }
 
 void Frustum::viewTranslate(const glm::vec3 &t)
 {
     mView = glm::translate(mView, t);
-    changed();
+    viewChanged();
 }
 
 void Frustum::viewTranslate(float x, float y, float z)
 {
     mView = glm::translate(mView, glm::vec3(x, y, z));
-    changed();
+    viewChanged();
 }
 
 glm::vec3 Frustum::getX() const
@@ -215,6 +296,18 @@ void Frustum::update()
     getInvViewProj();
     getNormal();
     getCorner(0);
+
+    const auto version = getViewProjVersion();
+    if (version == mUpdatedVersion) {
+        return;
+    }
+    mUpdatedVersion = version;
+
+    mSnapshot.store(FrustumSnapshot{ mView, mProj, mViewProj, mInvViewProj, mNear, mFar, version });
+
+    notify([](auto *x){
+        x->onViewProjChanged();
+    });
 }
 
 }
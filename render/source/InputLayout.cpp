@@ -15,17 +15,29 @@ namespace gmt
 namespace
 {
 
-GLint getScalarTypeSize(GLenum type)
+// Bytes taken by size components.
+GLint getAttributeSize(GLenum type, GLint size)
 {
     switch (type) {
+    case GL_BYTE:
     case GL_UNSIGNED_BYTE:
-        return 1;
+        return size;
+
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+        return 2 * size;
 
     case GL_FLOAT:
-        return 4;
+        return 4 * size;
         
     case GL_DOUBLE:
-        return 8;
+        return 8 * size;
+
+    case GL_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+        assert(size == 4);
+        return 4;
 
     default:
         assert(false);
@@ -33,6 +45,39 @@ GLint getScalarTypeSize(GLenum type)
     }
 }
 
+GLenum getScalarType(ScalarType scalarType, GLenum shaderScalarType)
+{
+    switch (scalarType) {
+    case ScalarType::Float:
+        return GL_FLOAT;
+
+    case ScalarType::HalfFloat:
+        return GL_HALF_FLOAT;
+
+    case ScalarType::Byte:
+        return GL_BYTE;
+
+    case ScalarType::UnsignedByte:
+        return GL_UNSIGNED_BYTE;
+
+    case ScalarType::Short:
+    case ScalarType::OctahedralNormal:
+        return GL_SHORT;
+
+    case ScalarType::UnsignedShort:
+        return GL_UNSIGNED_SHORT;
+
+    case ScalarType::Int2101010Rev:
+        return GL_INT_2_10_10_10_REV;
+
+    case ScalarType::UnsignedInt2101010Rev:
+        return GL_UNSIGNED_INT_2_10_10_10_REV;
+
+    default:
+        return shaderScalarType;
+    }
+}
+
 bool unpackType(GLenum type, GLint *size, GLenum *scalarType, GLuint *scalarCount)
 {
     *scalarCount = 1;
@@ -78,6 +123,55 @@ bool unpackType(GLenum type, GLint *size, GLenum *scalarType, GLuint *scalarCoun
         *scalarType = GL_DOUBLE;
         break;
         
+    // Matrices take a location per column, matCxR has C columns of R components.
+    case GL_FLOAT_MAT2:
+        *scalarCount = 2;
+        *size = 2;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT2x3:
+        *scalarCount = 2;
+        *size = 3;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT2x4:
+        *scalarCount = 2;
+        *size = 4;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT3:
+        *scalarCount = 3;
+        *size = 3;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT3x2:
+        *scalarCount = 3;
+        *size = 2;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT3x4:
+        *scalarCount = 3;
+        *size = 4;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT4x2:
+        *scalarCount = 4;
+        *size = 2;
+        *scalarType = GL_FLOAT;
+        break;
+
+    case GL_FLOAT_MAT4x3:
+        *scalarCount = 4;
+        *size = 3;
+        *scalarType = GL_FLOAT;
+        break;
+
     case GL_FLOAT_MAT4:
         *scalarCount = 4;
         *size = 4;
@@ -121,18 +215,21 @@ InputLayoutEditor &InputLayoutEditor::setAttribute(const std::string &name, bool
         size = componentsCount;
     }
 
-    shaderScalarType =
-        scalarType == ScalarType::Float ? GL_FLOAT :
-        scalarType == ScalarType::UnsignedByte ? GL_UNSIGNED_BYTE : shaderScalarType;
+    if (scalarType == ScalarType::OctahedralNormal) {
+        size = 2;
+        normalized = true;
+    }
+
+    shaderScalarType = getScalarType(scalarType, shaderScalarType);
 
-    auto scalarSize = getScalarTypeSize(shaderScalarType);
+    auto attributeSize = getAttributeSize(shaderScalarType, size);
     for (GLuint i = 0; i < shaderScalarCount; i++) {
         detail::AttributeBinding binding;
         binding.location = attribute->location() + i;
         binding.size = size;
         binding.type = shaderScalarType;
         binding.ptr = (void*)(reinterpret_cast<uintptr_t>(ptr) 
-            + static_cast<uintptr_t>(i) * size * scalarSize);
+            + static_cast<uintptr_t>(i) * attributeSize);
         binding.stride = stride;
         binding.normalized = normalized;
         binding.instanced = instanced;
@@ -141,7 +238,7 @@ InputLayoutEditor &InputLayoutEditor::setAttribute(const std::string &name, bool
         events_.push(detail::InputLayoutEditorEvent::BindAttribute);
     }
     nextAttributePtr_ = reinterpret_cast<uint8_t*>(ptr) 
-        + static_cast<uintptr_t>(shaderScalarCount) * size * scalarSize;
+        + static_cast<uintptr_t>(shaderScalarCount) * attributeSize;
     return *this;
 }
 
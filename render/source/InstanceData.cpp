@@ -0,0 +1,42 @@
+#include "gmt/render/InstanceData.h"
+
+namespace gmt
+{
+
+void packInstances(const TrsArray &trs, InstanceTrs *destination)
+{
+    for (size_t i = 0; i < trs.size(); i++) {
+        destination[i].positionScale = { trs.positionX[i], trs.positionY[i], trs.positionZ[i], trs.scaleX[i] };
+        destination[i].rotation = { trs.rotationX[i], trs.rotationY[i], trs.rotationZ[i], trs.rotationW[i] };
+    }
+}
+
+const char *const instanceGlsl = R"(
+vec3 quatRotate(vec4 q, vec3 v)
+{
+    vec3 t = 2.0 * cross(q.xyz, v);
+    return v + q.w * t + cross(q.xyz, t);
+}
+
+mat3x4 instanceMatrix(vec4 row0, vec4 row1, vec4 row2)
+{
+    return mat3x4(row0, row1, row2);
+}
+
+vec3 instanceTransform(mat3x4 m, vec3 p)
+{
+    return vec4(p, 1.0) * m;
+}
+
+vec3 instanceTransform(vec4 positionScale, vec4 rotation, vec3 p)
+{
+    return positionScale.xyz + quatRotate(rotation, p * positionScale.w);
+}
+
+vec3 instanceTransformNormal(vec4 rotation, vec3 n)
+{
+    return quatRotate(rotation, n);
+}
+)";
+
+}
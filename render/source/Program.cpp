@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <iterator>
 
+#include "gmt/render/Log.h"
 #include "gmt/render/OpenGL.h"
 #include "gmt/Utils.h"
 
@@ -25,7 +26,7 @@ void logShaderInfo(GLuint shader)
 
     std::vector<char> data(length);
     glGetShaderInfoLog(shader, length, nullptr, data.data());
-    utils::log(data.data());
+    GMT_LOG_ERROR(renderLog, "{}", data.data());
 }
 
 void logProgramInfo(GLuint program)
@@ -38,7 +39,7 @@ void logProgramInfo(GLuint program)
 
     std::vector<GLchar> data(length);
     glGetProgramInfoLog(program, length, nullptr, data.data());
-    utils::log(data.data());
+    GMT_LOG_ERROR(renderLog, "{}", data.data());
 }
 
 bool checkCompileStatus(GLuint shader)
@@ -46,7 +47,7 @@ bool checkCompileStatus(GLuint shader)
     GLint compileStatus;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
     if (compileStatus == GL_FALSE) {
-        utils::log("Error compiling shader");
+        GMT_LOG_ERROR(renderLog, "Error compiling shader");
         logShaderInfo(shader);
         return false;
     }
@@ -87,7 +88,7 @@ void loadAttributeLocations(GLuint program, std::unordered_map<std::string, Attr
         auto location = glGetAttribLocation(program, name.data());
         auto namestr = std::string(name.begin(), name.begin() + len);
         Attribute p{ static_cast<GLuint>(location), size, type };
-        utils::log("Attribute(", namestr, ") located at ", p.location());
+        GMT_LOG_DEBUG(renderLog, "Attribute({}) located at {}", namestr, p.location());
         locations->emplace(std::move(namestr), std::move(p));
     }
 }
@@ -109,7 +110,7 @@ void loadUniformLocations(GLuint program, std::vector<UniformInfo> *uniforms)
         glGetActiveUniform(program, i, maxLength,  &len, &size, &type, buffer.data());
         auto location = glGetUniformLocation(program, buffer.data());
         auto name = std::string(buffer.begin(), buffer.begin() + len);
-        utils::log("Uniform(", name, ") located at ", location);
+        GMT_LOG_DEBUG(renderLog, "Uniform({}) located at {}", name, location);
         uniforms->emplace_back(std::move(name), location);
     }
 }
@@ -133,7 +134,7 @@ GLuint compileProgram(GLuint vs, GLuint tcs, GLuint tes, GLuint fs)
     glGetProgramiv(program, GL_LINK_STATUS, &linked);
 
     if (!linked) {
-        utils::log("Failed to link program");
+        GMT_LOG_ERROR(renderLog, "Failed to link program");
         detail::logProgramInfo(program);
         glDeleteProgram(program);
         return 0;
@@ -251,7 +252,7 @@ const Attribute *Program::attribute(const std::string &name) const
 {
     auto it = mAttributes.find(name);
     if (it == mAttributes.end()) {
-        utils::log("Unknown attribute: ", name);
+        GMT_LOG_WARNING(renderLog, "Unknown attribute: {}", name);
         return nullptr;
     }
     
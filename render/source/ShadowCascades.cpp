@@ -0,0 +1,128 @@
+#include "gmt/render/ShadowCascades.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace gmt
+{
+
+namespace
+{
+
+// Radii are rounded up to this step, float noise in the corners must not resize the projection.
+constexpr float radiusQuantum = 1.0f / 16.0f;
+
+glm::mat4 lightRotation(const glm::vec3 &direction)
+{
+    const auto up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    return glm::lookAt(glm::vec3(0.0f), direction, up);
+}
+
+}
+
+void ShadowCascades::computeSplits(float near, float far, int count, float lambda, float *distances)
+{
+    assert(far > near && count > 0);
+
+    // Logarithmic splits need a positive near distance, orthographic cameras may start at 0 or
+    // behind the eye and get uniform ones.
+    if (near <= 0.0f) {
+        lambda = 0.0f;
+    }
+
+    for (int i = 0; i <= count; i++) {
+        const auto f = static_cast<float>(i) / count;
+        const auto logarithmic = lambda > 0.0f ? near * std::pow(far / near, f) : 0.0f;
+        const auto uniform = near + (far - near) * f;
+        distances[i] = lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+
+    // Exact ends, pow is not.
+    distances[0] = near;
+    distances[count] = far;
+}
+
+ShadowCascades::ShadowCascades(int count, int resolution)
+    : cascades_(count)
+    , splits_(count)
+    , resolution_{ resolution }
+{
+    assert(count > 0 && count <= maxCount);
+}
+
+uint32_t ShadowCascades::update(const Frustum &camera, const glm::vec3 &lightDirection)
+{
+    const auto near = camera.getNear();
+    const auto far = std::min(camera.getFar(), maxDistance_);
+    assert(std::isfinite(far) && "Set a max distance for infinite projections");
+    const auto count = this->count();
+
+    std::array<float, maxCount + 1> distances;
+    computeSplits(near, far, count, lambda_, distances.data());
+
+    // Frustum edges scaled to advance one unit of view depth, far corners are directions
+    // with an infinite far plane.
+    const auto forward = -camera.getZ();
+    glm::vec3 nearCorners[4];
+    glm::vec3 edges[4];
+    for (int i = 0; i < 4; i++) {
+        nearCorners[i] = glm::vec3(camera.getCorner(i));
+        const auto &farCorner = camera.getCorner(i + 4);
+        const auto edge = glm::vec3(farCorner) - nearCorners[i] * farCorner.w;
+        edges[i] = edge / glm::dot(edge, forward);
+    }
+
+    const auto view = lightRotation(glm::normalize(lightDirection));
+
+    uint32_t changed = 0;
+    for (int c = 0; c < count; c++) {
+        glm::vec3 corners[8];
+        for (int i = 0; i < 4; i++) {
+            corners[i] = nearCorners[i] + edges[i] * (distances[c] - near);
+            corners[i + 4] = nearCorners[i] + edges[i] * (distances[c + 1] - near);
+        }
+
+        // Centroid and farthest corner move rigidly with the camera, unlike a tight fit.
+        glm::vec3 center{ 0.0f };
+        for (const auto &p : corners) {
+            center += p * 0.125f;
+        }
+        float radius = 0.0f;
+        for (const auto &p : corners) {
+            radius = std::max(radius, glm::length(p - center));
+        }
+        radius = std::ceil(radius / radiusQuantum) * radiusQuantum;
+
+        // Snap the light space origin down to whole texels, depth too so the projection stays unchanged.
+        // The extra texel covers the snapping offset.
+        const auto texel = 2.0f * radius / (resolution_ - 1);
+        const auto origin = glm::floor(glm::vec3(view * glm::vec4(center, 1.0f)) / texel) * texel;
+        const auto extent = radius + texel;
+
+        // The light looks down -z, casters towards the light have a greater z.
+        const auto proj = glm::ortho(origin.x - radius, origin.x + extent, origin.y - radius, origin.y + extent,
+            -origin.z - extent - castersDistance_, -origin.z + radius);
+        const auto viewProj = proj * view;
+
+        auto &cascade = cascades_[c];
+        if (cascade.viewProj != viewProj) {
+            changed |= 1u << c;
+        }
+
+        cascade.splitNear = distances[c];
+        cascade.splitFar = distances[c + 1];
+        cascade.bounds = Sphere{ center, radius };
+        cascade.view = view;
+        cascade.proj = proj;
+        cascade.viewProj = viewProj;
+        splits_[c] = cascade.splitFar;
+    }
+
+    return changed;
+}
+
+}
@@ -99,7 +99,7 @@ SampleMesh::SampleMesh(bool instanced)
 {
     if (instanced) {
         for (int i = 0; i < 4; i++) {
-            instancesData_[i] = glm::mat4x4{};
+            instancesData_[i] = glm::mat3x4{};
         }
         instances_.reset(new gmt::VertexBuffer{ gmt::VertexBuffer::create<GL_ARRAY_BUFFER>(instancesData_, GL_DYNAMIC_DRAW) });
     }
@@ -122,7 +122,7 @@ gmt::InputLayout SampleMesh::createInputLayout(const gmt::Program &program) cons
     if (instances_) {
         editor
             .bind(instances_.get())
-            .setAttribute("in_ModelMat", false, sizeof(glm::mat4x4), nullptr, 1);
+            .setAttribute("in_ModelMat", false, sizeof(glm::mat3x4), nullptr, 1);
     }
     
     editor.commit(&inputlayout);
@@ -141,12 +141,11 @@ void SampleMesh::updateInstances()
     glm::quat cubeQuat = glm::angleAxis(cubeAngle_, rotAxis);
     
     if (instances_) {
+        instancesTrs_.resize(instancesData_.size());
         for (int i = 0; i < (int)instancesData_.size(); i++) {
-            instancesData_[i] = glm::mat4x4{};
-            instancesData_[i] = glm::translate(instancesData_[i], glm::vec3{ i / 2 * 2 - 1, i % 2 * 2 - 1, 0.0f });
-            instancesData_[i] = glm::scale(instancesData_[i], glm::vec3{ 0.25f, 0.25f, 0.25f });
-            instancesData_[i] = instancesData_[i] * glm::mat4_cast(cubeQuat);
+            instancesTrs_.set(i, glm::vec3{ i / 2 * 2 - 1, i % 2 * 2 - 1, 0.0f }, cubeQuat, glm::vec3{ 0.25f });
         }
+        gmt::trs::toMatrices(instancesTrs_, instancesData_.data());
 
         gmt::VertexBufferEditor{ instances_.get() }
             .bufferSubData(0, instancesData_)
@@ -30,7 +30,8 @@ private:
     gmt::VertexBuffer indices_;
     std::unique_ptr<gmt::VertexBuffer> instances_;
 
-    std::array<glm::mat4x4, 4> instancesData_;
+    gmt::TrsArray instancesTrs_;
+    std::array<glm::mat3x4, 4> instancesData_;
     float cubeAngle_{ 0.0f };
     std::chrono::high_resolution_clock::time_point updateTime_;
 };
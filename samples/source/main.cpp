@@ -58,6 +58,7 @@ int main(int argc, const char * argv[])
     
     glfwGetFramebufferSize(window, &width, &height);
     context.reset(new GlfwContext{ width, height });
+    context->setDeferredEvents(true);
 
     /* Make the window's context current */
     glfwMakeContextCurrent(window);
@@ -85,6 +86,7 @@ int main(int argc, const char * argv[])
 
         while (!glfwWindowShouldClose(window))
         {
+            context->dispatchEvents();
             scene.update();
 
             scene.render();
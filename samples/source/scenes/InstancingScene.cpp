@@ -14,6 +14,8 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include "gmt/render/InstanceData.h"
+
 #include "Common.h"
 #include "ShaderTypes.h"
 
@@ -22,7 +24,7 @@ InstancingScene::InstancingScene(gmt::Context *context)
     , gmt::EnableWeakFromThis<gmt::FrustumListener>{ this }
     , context_{ context }
     , program_{
-        std::string{},
+        gmt::instanceGlsl,
         gmt::assets::load<std::string>(R"(assets/shaders/instanced.vert)"),
         gmt::assets::load<std::string>(R"(assets/shaders/instanced.frag)") }
     , viewProjUniform_{ program_.uniform<gmt::UniformMat4f>("u_ViewProjectionMat") }